@@ -0,0 +1,169 @@
+// https://github.com/vinniefalco/LuaBridge
+//
+// Copyright 2019, Dmitry Tarakanov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <LuaBridge/detail/Stack.h>
+
+#include <cstdint>
+
+namespace luabridge {
+
+//==============================================================================
+/**
+  Base class of objects reachable through handles.
+
+  T is the class that derives from HandleObject; its subclasses share its
+  slot map. Each object takes a slot when it is constructed and releases it
+  when it is destroyed, which makes the handles to it stale:
+
+      class Widget : public luabridge::HandleObject <Widget> { ... };
+*/
+template <class T>
+class HandleObject
+{
+public:
+  typedef T HandleClass;
+
+  /** Get the slot map of the class.
+  */
+  static HandleSlots& getHandleSlots ()
+  {
+    static HandleSlots slots;
+    return slots;
+  }
+
+  /** Get the index of the slot of the object.
+  */
+  std::uint32_t getHandleIndex () const
+  {
+    return m_handleIndex;
+  }
+
+protected:
+  HandleObject ()
+    : m_handleIndex (getHandleSlots ().acquire (static_cast <T*> (this)))
+  {
+  }
+
+  /** A copy is another object, with its own slot.
+  */
+  HandleObject (HandleObject const&)
+    : m_handleIndex (getHandleSlots ().acquire (static_cast <T*> (this)))
+  {
+  }
+
+  HandleObject& operator= (HandleObject const&)
+  {
+    return *this;
+  }
+
+  ~HandleObject ()
+  {
+    getHandleSlots ().release (m_handleIndex);
+  }
+
+private:
+  std::uint32_t const m_handleIndex;
+};
+
+//==============================================================================
+/**
+  A weak reference to an object derived from HandleObject.
+
+  A handle is a slot index and the generation of the slot, so it is cheap to
+  copy and needs neither reference counting nor a finalizer. Once the object
+  is destroyed, get () returns 0, Lua receives nil for the handle, and using a
+  handle already pushed to Lua raises an error instead of touching freed
+  memory. The lifetime of the object is managed by C++.
+*/
+template <class T>
+class Handle : public HandleBase
+{
+public:
+  /** Construct an empty handle.
+  */
+  Handle ()
+  {
+  }
+
+  /** Construct a handle to an object, or an empty handle from 0.
+  */
+  Handle (T* object)
+    : HandleBase (object != 0 ? Handle (*object) : Handle ())
+  {
+  }
+
+  /** Construct a handle to an object.
+  */
+  Handle (T& object)
+    : HandleBase (T::getHandleSlots (), object.getHandleIndex ())
+  {
+  }
+
+  /** Get the object, or 0 if the handle is empty or the object was destroyed.
+  */
+  T* get () const
+  {
+    return static_cast <T*> (static_cast <typename T::HandleClass*> (getObject ()));
+  }
+
+  T* operator-> () const
+  {
+    return get ();
+  }
+
+  T& operator* () const
+  {
+    return *get ();
+  }
+
+  /** Determine if the object is alive.
+  */
+  bool isValid () const
+  {
+    return getObject () != 0;
+  }
+};
+
+template <class T>
+bool operator== (Handle <T> const& lhs, Handle <T> const& rhs)
+{
+  return lhs.get () == rhs.get ();
+}
+
+template <class T>
+bool operator!= (Handle <T> const& lhs, Handle <T> const& rhs)
+{
+  return lhs.get () != rhs.get ();
+}
+
+//==============================================================================
+/**
+  Handles are passed to Lua as handle userdata, validated on each access.
+
+  They are not containers for ContainerTraits: a container userdata keeps the
+  object pointer it was made with, which outlives the object of a handle.
+*/
+template <class T>
+struct Stack <Handle <T> >
+{
+  static void push (lua_State* L, Handle <T> const& handle)
+  {
+    UserdataHandle::push <T> (L, handle);
+  }
+
+  static Handle <T> get (lua_State* L, int index)
+  {
+    return Handle <T> (Userdata::get <T> (L, index, false));
+  }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return lua_isnil (L, index) || Userdata::isInstance <T> (L, index, false);
+  }
+};
+
+} // namespace luabridge
@@ -45,6 +45,11 @@ struct Stack <std::list <T> >
     }
     return list;
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return lua_istable (L, index);
+  }
 };
 
 } // namespace luabridge
@@ -51,8 +51,10 @@
 #include <LuaBridge/detail/LuaException.h>
 #include <LuaBridge/detail/LuaRef.h>
 #include <LuaBridge/detail/Iterator.h>
+#include <LuaBridge/detail/HandleSlots.h>
 #include <LuaBridge/detail/Userdata.h>
 #include <LuaBridge/detail/CFunctions.h>
+#include <LuaBridge/detail/RegistrationOptions.h>
 #include <LuaBridge/detail/Security.h>
 #include <LuaBridge/detail/Stack.h>
 #include <LuaBridge/detail/Namespace.h>
@@ -0,0 +1,275 @@
+// https://github.com/vinniefalco/LuaBridge
+//
+// Copyright 2019, Dmitry Tarakanov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <LuaBridge/detail/LuaRef.h>
+
+namespace luabridge {
+
+/**
+ * The key of the message handler of LuaFunction calls in the registry.
+ */
+inline void* getMessageHandlerKey ()
+{
+  static char value;
+  return &value;
+}
+
+//------------------------------------------------------------------------------
+/**
+  The message handler of LuaFunction calls.
+
+  It appends a traceback of the Lua stack to string error messages, in the
+  same format on all Lua versions. Other error objects are left alone.
+*/
+inline int messageHandler (lua_State* L)
+{
+  if (!lua_isstring (L, 1))
+  {
+    return 1;
+  }
+
+  int const maxLevels = 20;
+  lua_Debug ar;
+  int level = 1;
+
+  lua_settop (L, 1);
+  lua_pushliteral (L, "\nstack traceback:");
+  for (; level <= maxLevels && lua_getstack (L, level, &ar); ++level)
+  {
+    lua_getinfo (L, "Snl", &ar);
+    lua_pushfstring (L, "\n\t%s:", ar.short_src);
+    if (ar.currentline > 0)
+    {
+      lua_pushfstring (L, "%d:", ar.currentline);
+    }
+    else
+    {
+      lua_pushliteral (L, "");
+    }
+    if (ar.name != 0)
+    {
+      lua_pushfstring (L, " in function '%s'", ar.name);
+    }
+    else if (*ar.what == 'm')
+    {
+      lua_pushliteral (L, " in main chunk");
+    }
+    else
+    {
+      lua_pushfstring (L, " in function <%s:%d>", ar.short_src, ar.linedefined);
+    }
+    lua_concat (L, 4); // Stack: message, traceback
+  }
+
+  if (lua_getstack (L, level, &ar))
+  {
+    lua_pushliteral (L, "\n\t...");
+    lua_concat (L, 2);
+  }
+
+  lua_concat (L, 2);
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+/**
+  Get the message handler of LuaFunction calls, creating it on first use.
+*/
+inline LuaRef getMessageHandler (lua_State* L)
+{
+  lua_rawgetp (L, LUA_REGISTRYINDEX, getMessageHandlerKey ());
+  if (lua_isnil (L, -1))
+  {
+    lua_pop (L, 1);
+    lua_pushcfunction (L, &messageHandler);
+    lua_pushvalue (L, -1);
+    lua_rawsetp (L, LUA_REGISTRYINDEX, getMessageHandlerKey ());
+  }
+  return LuaRef::fromStack (L);
+}
+
+//==============================================================================
+/**
+  How the results of a Lua call are converted to the result of a LuaFunction.
+*/
+template <class R>
+struct LuaFunctionResult
+{
+  static int const count = 1;
+
+  /** Convert the result on top of the stack and restore the stack top.
+  */
+  static R get (lua_State* L, int top)
+  {
+    R result = Stack <R>::get (L, -1);
+    lua_settop (L, top);
+    return result;
+  }
+};
+
+template <>
+struct LuaFunctionResult <void>
+{
+  static int const count = 0;
+
+  static void get (lua_State* L, int top)
+  {
+    lua_settop (L, top);
+  }
+};
+
+/**
+  A tuple of results requests as many values from the function.
+*/
+template <class... Results>
+struct LuaFunctionResult <std::tuple <Results...> > : CallResults <Results...>
+{
+};
+
+//==============================================================================
+/**
+  A typed handle to a Lua function, made for calling it repeatedly.
+
+  The function is kept in the registry once, when the handle is made. A call
+  pushes it with the arguments converted by their Stack specializations,
+  calls it under a message handler adding a traceback to errors, and converts
+  the result with Stack <R>::get, without a LuaRef in between. When R is a
+  std::tuple, the function returns a value for each of its elements. The
+  handle shares one message handler per lua_State, so a call does no registry
+  work and, with Lua 5.2, allocates nothing beyond what the function does.
+
+  The result is read before it is popped, so it must not point into Lua
+  memory: use std::string rather than char const* for strings. Errors are
+  thrown as LuaException, and the stack is left as it was.
+
+      LuaFunction <int (int, std::string const&)> f = getGlobal (L, "f");
+      int n = f (1, "one");
+
+  A LuaFunction may also be a parameter of a bound function, to keep a Lua
+  callback for later.
+*/
+template <class Signature>
+class LuaFunction;
+
+template <class R, class... Args>
+class LuaFunction <R (Args...)>
+{
+public:
+  //----------------------------------------------------------------------------
+  /**
+      Make a handle to the function referred to by a LuaRef or a proxy.
+  */
+  template <class Impl>
+  LuaFunction (LuaRefBase <Impl, LuaRef> const& function)
+    : m_function (function.state ())
+    , m_messageHandler (getMessageHandler (function.state ()))
+  {
+    function.push (function.state ());
+    m_function.pop ();
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+      Make a handle to the function at a stack index.
+  */
+  LuaFunction (lua_State* L, int index)
+    : m_function (LuaRef::fromStack (L, index))
+    , m_messageHandler (getMessageHandler (L))
+  {
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+      Get the function as a LuaRef.
+  */
+  LuaRef const& getRef () const
+  {
+    return m_function;
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+      Call the function.
+  */
+  R operator() (Args... args) const
+  {
+    lua_State* const L = m_function.state ();
+    int const top = lua_gettop (L);
+    StackRestore restore (L, top);
+
+    m_messageHandler.push (L);
+    m_function.push (L);
+    int const pushed [] = {0, (Stack <Args>::push (L, args), 0)...};
+    (void) pushed;
+
+    int const code = lua_pcall (L,
+      int (sizeof... (Args)), LuaFunctionResult <R>::count, top + 1);
+    if (code != LUABRIDGE_LUA_OK)
+    {
+      LuaException::Throw (LuaException (L, code));
+    }
+
+    lua_remove (L, top + 1); // the message handler
+    return LuaFunctionResult <R>::get (L, top);
+  }
+
+private:
+  //----------------------------------------------------------------------------
+  /**
+      Restores the stack top on destruction, also when an argument or the
+      result fails to convert.
+  */
+  class StackRestore
+  {
+  public:
+    StackRestore (lua_State* L, int top)
+      : m_L (L)
+      , m_top (top)
+    {
+    }
+
+    ~StackRestore ()
+    {
+      lua_settop (m_L, m_top);
+    }
+
+  private:
+    lua_State* m_L;
+    int m_top;
+  };
+
+  LuaRef m_function;
+  LuaRef m_messageHandler;
+};
+
+//------------------------------------------------------------------------------
+/**
+  Stack specialization for LuaFunction.
+
+  Only Lua and C functions are accepted, not callable tables or userdata.
+*/
+template <class R, class... Args>
+struct Stack <LuaFunction <R (Args...)> >
+{
+  static void push (lua_State* L, LuaFunction <R (Args...)> const& function)
+  {
+    function.getRef ().push (L);
+  }
+
+  static LuaFunction <R (Args...)> get (lua_State* L, int index)
+  {
+    luaL_checktype (L, index, LUA_TFUNCTION);
+    return LuaFunction <R (Args...)> (L, index);
+  }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return lua_isfunction (L, index);
+  }
+};
+
+} // namespace luabridge
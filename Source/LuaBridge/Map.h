@@ -45,6 +45,11 @@ struct Stack <std::map <K, V> >
     }
     return map;
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return lua_istable (L, index);
+  }
 };
 
 } // namespace luabridge
@@ -0,0 +1,168 @@
+// https://github.com/vinniefalco/LuaBridge
+//
+// Copyright 2019, Dmitry Tarakanov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+
+namespace luabridge {
+
+//==============================================================================
+/**
+  A lua_Alloc enforcing a hard limit on the memory of a lua_State.
+
+  An allocation that would take the memory in use over the budget fails.
+  Lua 5.2 and later then run an emergency full collection and retry the
+  allocation once, so only the memory still reachable counts against the
+  budget. If it still does not fit, or with Lua 5.1 which has no emergency
+  collection, Lua raises a memory error. Shrinking and freeing always
+  succeed.
+
+  The blocks come from another lua_Alloc, the C runtime by default, so that
+  the budget can be combined with a SlabAllocator.
+
+  The memory in use is tracked on each allocation, so it is read without
+  calling into Lua, from any thread. Each lua_State needs its own budget,
+  which must outlive it:
+
+      MemoryBudget budget (64 * 1024 * 1024);
+      lua_State* L = lua_newstate (&MemoryBudget::alloc, &budget);
+*/
+class MemoryBudget
+{
+public:
+  explicit MemoryBudget (std::size_t budget, lua_Alloc alloc = &defaultAlloc, void* ud = 0)
+    : m_alloc (alloc)
+    , m_ud (ud)
+    , m_budget (budget)
+    , m_bytesInUse (0)
+    , m_peakBytesInUse (0)
+    , m_failedAllocations (0)
+  {
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+    Change the budget. Lowering it below the memory in use makes further
+    allocations fail until enough memory is freed.
+  */
+  void setBudget (std::size_t budget)
+  {
+    m_budget.store (budget, std::memory_order_relaxed);
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+    Get the budget in bytes.
+  */
+  std::size_t getBudget () const
+  {
+    return m_budget.load (std::memory_order_relaxed);
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+    Get the bytes allocated by Lua and not freed.
+  */
+  std::size_t getBytesInUse () const
+  {
+    return m_bytesInUse.load (std::memory_order_relaxed);
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+    Get the largest number of bytes in use so far.
+  */
+  std::size_t getPeakBytesInUse () const
+  {
+    return m_peakBytesInUse.load (std::memory_order_relaxed);
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+    Get the number of allocations refused by the budget or failed by the
+    underlying allocator, including those Lua retried successfully.
+  */
+  std::size_t getFailedAllocations () const
+  {
+    return m_failedAllocations.load (std::memory_order_relaxed);
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+    The lua_Alloc function. The user data is the budget.
+  */
+  static void* alloc (void* ud, void* ptr, std::size_t osize, std::size_t nsize)
+  {
+    return static_cast <MemoryBudget*> (ud)->reallocate (ptr, osize, nsize);
+  }
+
+private:
+  MemoryBudget (MemoryBudget const&);
+  MemoryBudget& operator= (MemoryBudget const&);
+
+  static void* defaultAlloc (void*, void* ptr, std::size_t, std::size_t nsize)
+  {
+    if (nsize == 0)
+    {
+      std::free (ptr);
+      return 0;
+    }
+    return std::realloc (ptr, nsize);
+  }
+
+  void* reallocate (void* ptr, std::size_t osize, std::size_t nsize)
+  {
+    // Lua 5.2 passes the type of a new object in osize.
+    std::size_t const oldSize = ptr != 0 ? osize : 0;
+
+    // Lua runs the allocator of a state on one thread at a time, so the
+    // counters are written without read-modify-write operations.
+    std::size_t const inUse = m_bytesInUse.load (std::memory_order_relaxed);
+
+    if (nsize > oldSize)
+    {
+      std::size_t const growth = nsize - oldSize;
+      std::size_t const budget = getBudget ();
+      if (growth > budget || inUse > budget - growth)
+      {
+        countFailure ();
+        return 0;
+      }
+    }
+
+    void* const p = m_alloc (m_ud, ptr, osize, nsize);
+    if (p == 0 && nsize != 0)
+    {
+      countFailure ();
+      return 0;
+    }
+
+    std::size_t const newInUse = inUse - oldSize + nsize;
+    m_bytesInUse.store (newInUse, std::memory_order_relaxed);
+    if (newInUse > m_peakBytesInUse.load (std::memory_order_relaxed))
+    {
+      m_peakBytesInUse.store (newInUse, std::memory_order_relaxed);
+    }
+    return p;
+  }
+
+  void countFailure ()
+  {
+    m_failedAllocations.store (
+      m_failedAllocations.load (std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  }
+
+  lua_Alloc const m_alloc;
+  void* const m_ud;
+  std::atomic <std::size_t> m_budget;
+  std::atomic <std::size_t> m_bytesInUse;
+  std::atomic <std::size_t> m_peakBytesInUse;
+  std::atomic <std::size_t> m_failedAllocations;
+};
+
+} // namespace luabridge
@@ -0,0 +1,327 @@
+// https://github.com/vinniefalco/LuaBridge
+//
+// Copyright 2019, Dmitry Tarakanov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <LuaBridge/detail/Userdata.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace luabridge {
+
+//==============================================================================
+/**
+  A lua_Alloc with free lists for small blocks.
+
+  Blocks up to the largest size class are rounded up to a multiple of the
+  granularity and carved from slabs, one free list per size class. Freed
+  blocks go back to their free list and are reused by later allocations of
+  the same class; slabs are released only when the allocator is destroyed.
+  Larger blocks go to the C runtime.
+
+  The size classes cover the small strings, tables and closures of Lua by
+  default. Call addClass () for the classes pushed by value, so that their
+  userdata are served from the free lists too. The size classes must be set
+  before the allocator is used.
+
+  The allocator must outlive the lua_State, and is not thread safe:
+
+      SlabAllocator allocator;
+      allocator.addClass <Vec3> ();
+      lua_State* L = lua_newstate (&SlabAllocator::alloc, &allocator);
+*/
+class SlabAllocator
+{
+public:
+  /** Allocation counters.
+  */
+  struct Statistics
+  {
+    Statistics ()
+      : allocations (0)
+      , deallocations (0)
+      , pooledAllocations (0)
+      , slabs (0)
+      , bytesInUse (0)
+    {
+    }
+
+    std::size_t allocations; // blocks allocated
+    std::size_t deallocations; // blocks freed
+    std::size_t pooledAllocations; // blocks taken from a free list
+    std::size_t slabs; // slabs allocated
+    std::size_t bytesInUse; // bytes requested by Lua and not freed
+  };
+
+  /** The size classes are multiples of the granularity.
+  */
+  static std::size_t const granularity = 16;
+
+  /** An upper bound of the bytes Lua adds to a userdata for its header.
+  */
+  static std::size_t const userdataHeaderSize = 8 * sizeof (void*);
+
+  /** The size of the memory carved into blocks of a size class.
+  */
+  static std::size_t const slabSize = 16 * 1024;
+
+  explicit SlabAllocator (std::size_t maxBlockSize = 256)
+    : m_freeLists (classIndex (std::max (maxBlockSize, std::size_t (granularity))) + 1)
+  {
+  }
+
+  ~SlabAllocator ()
+  {
+    for (std::size_t i = 0; i < m_slabs.size (); ++i)
+    {
+      std::free (m_slabs [i]);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+    Make blocks of the given size come from the free lists.
+  */
+  void addSize (std::size_t size)
+  {
+    if (m_statistics.allocations != 0)
+    {
+      throw std::logic_error ("The size classes cannot change once the allocator is used");
+    }
+
+    std::size_t const index = classIndex (std::max (size, std::size_t (granularity)));
+    if (index >= m_freeLists.size ())
+    {
+      m_freeLists.resize (index + 1);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+    Make the userdata of class objects pushed by value come from the free
+    lists.
+  */
+  template <class T>
+  void addClass ()
+  {
+    addSize (sizeof (UserdataValue <T>) + userdataHeaderSize);
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+    Get the largest block size served from the free lists.
+  */
+  std::size_t getMaxBlockSize () const
+  {
+    return m_freeLists.size () * granularity;
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+    Get the allocation counters.
+  */
+  Statistics const& getStatistics () const
+  {
+    return m_statistics;
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+    The lua_Alloc function. The user data is the allocator.
+  */
+  static void* alloc (void* ud, void* ptr, std::size_t osize, std::size_t nsize)
+  {
+    return static_cast <SlabAllocator*> (ud)->reallocate (ptr, ptr != 0 ? osize : 0, nsize);
+  }
+
+private:
+  SlabAllocator (SlabAllocator const&);
+  SlabAllocator& operator= (SlabAllocator const&);
+
+  /** A free block, linked to the next one of its size class.
+  */
+  struct FreeBlock
+  {
+    FreeBlock* next;
+  };
+
+  static std::size_t classIndex (std::size_t size)
+  {
+    return (size + granularity - 1) / granularity - 1;
+  }
+
+  bool isPooled (std::size_t size) const
+  {
+    return size != 0 && classIndex (size) < m_freeLists.size ();
+  }
+
+  void* reallocate (void* ptr, std::size_t osize, std::size_t nsize)
+  {
+    if (nsize == 0)
+    {
+      deallocate (ptr, osize);
+      return 0;
+    }
+
+    if (ptr == 0)
+    {
+      return allocate (nsize);
+    }
+
+    bool const wasPooled = isPooled (osize);
+    bool const isPooledNow = isPooled (nsize);
+
+    if (wasPooled && isPooledNow && classIndex (osize) == classIndex (nsize))
+    {
+      m_statistics.bytesInUse += nsize - osize;
+      return ptr;
+    }
+
+    if (!wasPooled && !isPooledNow)
+    {
+      void* const p = std::realloc (ptr, nsize);
+      if (p != 0)
+      {
+        m_statistics.bytesInUse += nsize - osize;
+      }
+      return p;
+    }
+
+    void* const p = allocate (nsize);
+    if (p == 0)
+    {
+      // Lua does not expect a block to fail to shrink. The block is kept,
+      // and will join the free list of its new size class when freed.
+      if (nsize < osize)
+      {
+        return keep (ptr, osize, nsize);
+      }
+      return 0;
+    }
+
+    std::memcpy (p, ptr, std::min (osize, nsize));
+    deallocate (ptr, osize);
+    return p;
+  }
+
+  /** Keep a block shrunk to a pooled size for which no block is free.
+
+      A block from the C runtime is owned by the allocator from then on,
+      like a slab, since freeing it puts it on a free list.
+  */
+  void* keep (void* ptr, std::size_t osize, std::size_t nsize)
+  {
+    if (!isPooled (osize))
+    {
+      try
+      {
+        m_slabs.push_back (ptr);
+      }
+      catch (...)
+      {
+        return 0;
+      }
+    }
+
+    m_statistics.bytesInUse += nsize - osize;
+    return ptr;
+  }
+
+  void* allocate (std::size_t size)
+  {
+    void* p = 0;
+
+    if (isPooled (size))
+    {
+      FreeBlock*& freeList = m_freeLists [classIndex (size)];
+      if (freeList == 0)
+      {
+        addSlab (classIndex (size));
+      }
+
+      if (freeList != 0)
+      {
+        p = freeList;
+        freeList = freeList->next;
+        ++m_statistics.pooledAllocations;
+      }
+    }
+    else
+    {
+      p = std::malloc (size);
+    }
+
+    if (p != 0)
+    {
+      ++m_statistics.allocations;
+      m_statistics.bytesInUse += size;
+    }
+    return p;
+  }
+
+  void deallocate (void* ptr, std::size_t size)
+  {
+    if (ptr == 0)
+    {
+      return;
+    }
+
+    if (isPooled (size))
+    {
+      FreeBlock* const block = static_cast <FreeBlock*> (ptr);
+      block->next = m_freeLists [classIndex (size)];
+      m_freeLists [classIndex (size)] = block;
+    }
+    else
+    {
+      std::free (ptr);
+    }
+
+    ++m_statistics.deallocations;
+    m_statistics.bytesInUse -= size;
+  }
+
+  /** Carve a new slab into blocks of a size class.
+  */
+  void addSlab (std::size_t index)
+  {
+    std::size_t const blockSize = (index + 1) * granularity;
+    std::size_t const blockCount = std::max (slabSize / blockSize, std::size_t (1));
+
+    char* const slab = static_cast <char*> (std::malloc (blockSize * blockCount));
+    if (slab == 0)
+    {
+      return;
+    }
+    try
+    {
+      m_slabs.push_back (slab);
+    }
+    catch (...)
+    {
+      std::free (slab);
+      return;
+    }
+    ++m_statistics.slabs;
+
+    for (std::size_t i = blockCount; i-- > 0;)
+    {
+      FreeBlock* const block = reinterpret_cast <FreeBlock*> (slab + i * blockSize);
+      block->next = m_freeLists [index];
+      m_freeLists [index] = block;
+    }
+  }
+
+  std::vector <FreeBlock*> m_freeLists;
+  std::vector <void*> m_slabs; // and the blocks kept by keep ()
+  Statistics m_statistics;
+};
+
+} // namespace luabridge
@@ -44,6 +44,11 @@ struct Stack <std::vector <T> >
     }
     return vector;
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return lua_istable (L, index);
+  }
 };
 
 } // namespace luabridge
@@ -30,17 +30,377 @@
 #pragma once
 
 #include <string>
+#include <type_traits>
 
 namespace luabridge {
 
+//------------------------------------------------------------------------------
+/**
+    A native property accessor stored in a propget or propset table.
+
+    The __index and __newindex metamethods call the thunk directly instead of
+    going through lua_call. The object or table being indexed is at index 1,
+    the member name at index 2 and the new value, for a setter, at index 3.
+*/
+struct Accessor
+{
+  typedef int (*Thunk) (lua_State* L, Accessor const* accessor);
+
+  explicit Accessor (Thunk thunk_)
+    : thunk (thunk_)
+  {
+  }
+
+  Thunk const thunk;
+};
+
+/**
+    An accessor holding a data or function pointer.
+
+    Accessors live in userdata without a __gc metamethod so the data must
+    be trivially destructible.
+*/
+template <class Data>
+struct TypedAccessor : Accessor
+{
+  TypedAccessor (Thunk thunk_, Data data_)
+    : Accessor (thunk_)
+    , data (data_)
+  {
+  }
+
+  Data const data;
+};
+
+//------------------------------------------------------------------------------
+/**
+    Runs the body of a function thunk.
+
+    C++ exceptions thrown by the bound function, or by the conversion of its
+    arguments and result, are reported as Lua errors. Define
+    LUABRIDGE_NOTHROW_FUNCTIONS to omit the handler altogether, when Lua is
+    compiled as C++ and errors may propagate as C++ exceptions.
+*/
+struct CallGuard
+{
+  template <class Thunk, class... Args>
+  static int call (lua_State* L, Args... args)
+  {
+#if defined (LUABRIDGE_NOTHROW_FUNCTIONS)
+    return Thunk::invoke (L, args...);
+#else
+    try
+    {
+      return Thunk::invoke (L, args...);
+    }
+    catch (const std::exception& e)
+    {
+      return luaL_error (L, e.what ());
+    }
+#endif
+  }
+};
+
+//------------------------------------------------------------------------------
+/**
+    A function of an overload set, stored in an upvalue of the dispatcher.
+
+    The match function checks the number and the types of the arguments on
+    the Lua stack without raising errors, the invoke function calls the
+    function with them.
+*/
+struct Overload
+{
+  typedef bool (*Match) (lua_State* L);
+  typedef int (*Invoke) (lua_State* L, Overload const* overload);
+
+  Overload (Match match_, Invoke invoke_)
+    : match (match_)
+    , invoke (invoke_)
+  {
+  }
+
+  Match const match;
+  Invoke const invoke;
+};
+
+/**
+    An overload holding a function pointer.
+
+    Overloads live in userdata without a __gc metamethod so the data must
+    be trivially destructible.
+*/
+template <class Data>
+struct TypedOverload : Overload
+{
+  TypedOverload (Match match_, Invoke invoke_, Data data_)
+    : Overload (match_, invoke_)
+    , data (data_)
+  {
+  }
+
+  Data const data;
+};
+
+//------------------------------------------------------------------------------
+struct Method;
+
+/**
+    How to bind a method, or call it on each object of an array.
+
+    Methods are registered in large numbers and rarely bound, so they get
+    nothing but the closure calling them. The kind is found from the closure
+    when a method is bound or called on each object.
+*/
+struct MethodKind
+{
+  /** Push the method at the index bound to the object at index 1.
+  */
+  int (*bind) (lua_State* L, int methodIndex);
+
+  /** Call the method on each object of the array at index 1, with the
+      arguments from index 3. The upvalue of the method is null for methods
+      without upvalues.
+  */
+  int (*callEach) (lua_State* L, Method const* method);
+};
+
+/**
+    The upvalue of a method calling a member function pointer.
+
+    Methods live in userdata without a __gc metamethod so the data must be
+    trivially destructible. Their metatable is the method kinds table, which
+    tells them from other upvalues.
+*/
+struct Method
+{
+  explicit Method (MethodKind const* kind_)
+    : kind (kind_)
+  {
+  }
+
+  MethodKind const* const kind;
+};
+
+template <class Data>
+struct TypedMethod : Method
+{
+  TypedMethod (MethodKind const* kind_, Data data_)
+    : Method (kind_)
+    , data (data_)
+  {
+  }
+
+  Data const data;
+};
+
+//------------------------------------------------------------------------------
+/**
+    A range of C++ objects to call a method on, passed by callEach () from
+    C++ as a light userdata in place of the array.
+
+    The next function gets the pointer to the current object and advances,
+    or returns false at the end of the range.
+*/
+struct ObjectRange
+{
+  typedef bool (*Next) (ObjectRange* range, void const** object);
+
+  ObjectRange (Next next_, void const* classKey_)
+    : next (next_)
+    , classKey (classKey_)
+  {
+  }
+
+  Next const next;
+
+  /** The registry key of the class or const table of the objects.
+  */
+  void const* const classKey;
+};
+
+/**
+    Get a pointer to an object from an element of a range, which is either
+    a pointer or the object.
+*/
+template <class T>
+T* getObjectPointer (T* object)
+{
+  return object;
+}
+
+template <class T>
+T* getObjectPointer (T& object)
+{
+  return &object;
+}
+
+/**
+    A range of C++ objects between two iterators.
+*/
+template <class Iterator>
+struct TypedObjectRange : ObjectRange
+{
+  typedef typename std::remove_pointer <
+    decltype (getObjectPointer (*std::declval <Iterator&> ()))>::type Object;
+  typedef typename std::remove_const <Object>::type T;
+
+  TypedObjectRange (Iterator first_, Iterator last_)
+    : ObjectRange (&getNext, std::is_const <Object>::value ?
+        ClassInfo <T>::getConstKey () : ClassInfo <T>::getClassKey ())
+    , first (first_)
+    , last (last_)
+  {
+  }
+
+  static bool getNext (ObjectRange* range, void const** object)
+  {
+    TypedObjectRange* const self = static_cast <TypedObjectRange*> (range);
+    if (self->first == self->last)
+      return false;
+    *object = getObjectPointer (*self->first);
+    ++self->first;
+    return true;
+  }
+
+  Iterator first;
+  Iterator const last;
+};
+
+//------------------------------------------------------------------------------
+/**
+    The types of the arguments of a call.
+
+    This is the Lua type of each argument, and the metatable of each full
+    userdata, which identifies the class and the const-ness of our objects.
+    C functions get a type of their own, as only they convert to a
+    lua_CFunction. Together they determine which overload matches.
+*/
+struct OverloadSignature
+{
+  enum
+  {
+    maxArguments = 8,
+    cFunctionType = -2 // Apart from the LUA_T* constants
+  };
+
+  /** Read the signature of the arguments on the Lua stack.
+
+      Returns false if there are too many arguments to be remembered.
+  */
+  bool read (lua_State* L)
+  {
+    count = lua_gettop (L);
+    if (count > maxArguments)
+      return false;
+
+    for (int i = 0; i < count; ++i)
+    {
+      types [i] = lua_iscfunction (L, i + 1) ? int (cFunctionType) : lua_type (L, i + 1);
+      metatables [i] = 0;
+      if (types [i] == LUA_TUSERDATA && lua_getmetatable (L, i + 1))
+      {
+        metatables [i] = lua_topointer (L, -1);
+        lua_pop (L, 1);
+      }
+    }
+    return true;
+  }
+
+  bool operator== (OverloadSignature const& other) const
+  {
+    if (count != other.count)
+      return false;
+
+    for (int i = 0; i < count; ++i)
+    {
+      if (types [i] != other.types [i] || metatables [i] != other.metatables [i])
+        return false;
+    }
+    return true;
+  }
+
+  int count;
+  int types [maxArguments];
+  void const* metatables [maxArguments];
+};
+
+/**
+    The state of an overload set, stored in the first upvalue of the
+    dispatcher.
+
+    A small cache maps the signatures of recent calls to the overload that
+    was chosen, so repeated calls skip the resolution. The overloads are in
+    the following upvalues.
+*/
+struct OverloadSet
+{
+  enum { cacheSize = 4 };
+
+  explicit OverloadSet (int count_)
+    : count (count_)
+    , cached (0)
+    , next (0)
+  {
+  }
+
+  /** Returns the upvalue index of the overload, or 0 if not cached.
+  */
+  int find (OverloadSignature const& signature) const
+  {
+    for (int i = 0; i < cached; ++i)
+    {
+      if (signatures [i] == signature)
+        return overloads [i];
+    }
+    return 0;
+  }
+
+  void insert (OverloadSignature const& signature, int overload)
+  {
+    signatures [next] = signature;
+    overloads [next] = overload;
+    next = (next + 1) % cacheSize;
+    if (cached < cacheSize)
+      ++cached;
+  }
+
+  int const count;
+  int cached;
+  int next;
+  OverloadSignature signatures [cacheSize];
+  int overloads [cacheSize];
+};
+
 // We use a structure so we can define everything in the header.
 //
 struct CFunc
 {
+  //----------------------------------------------------------------------------
+  /**
+      Push a new accessor userdata.
+  */
+  static void pushAccessor (lua_State* L, Accessor::Thunk thunk)
+  {
+    new (lua_newuserdata (L, sizeof (Accessor))) Accessor (thunk);
+  }
+
+  template <class Data>
+  static void pushAccessor (lua_State* L, Accessor::Thunk thunk, Data data)
+  {
+    new (lua_newuserdata (L, sizeof (TypedAccessor <Data>))) TypedAccessor <Data> (thunk, data);
+  }
+
+  template <class Data>
+  static Data const& accessorData (Accessor const* accessor)
+  {
+    return static_cast <TypedAccessor <Data> const*> (accessor)->data;
+  }
+
   static void addGetter (lua_State* L, const char* name, int tableIndex)
   {
     assert (lua_istable (L, tableIndex));
-    assert (lua_iscfunction (L, -1)); // Stack: getter
+    assert (isfulluserdata (L, -1)); // Stack: getter
 
     lua_rawgetp (L, tableIndex, getPropgetKey ()); // Stack: getter, propget table (pg)
     lua_pushvalue (L, -2); // Stack: getter, pg, getter
@@ -51,7 +411,7 @@ struct CFunc
   static void addSetter (lua_State* L, const char* name, int tableIndex)
   {
     assert (lua_istable (L, tableIndex));
-    assert (lua_iscfunction (L, -1)); // Stack: setter
+    assert (isfulluserdata (L, -1)); // Stack: setter
 
     lua_rawgetp (L, tableIndex, getPropsetKey ()); // Stack: setter, propset table (ps)
     lua_pushvalue (L, -2); // Stack: setter, ps, setter
@@ -69,7 +429,7 @@ struct CFunc
   {
     assert (lua_istable (L, 1) || lua_isuserdata (L, 1)); // Stack (further not shown): table | userdata, name
 
-    lua_getmetatable (L, 1); // Stack: class/const table (mt)
+    getObjectMetatable (L, 1); // Stack: class/const table (mt)
     assert (lua_istable (L, -1));
 
     for (;;)
@@ -93,12 +453,10 @@ struct CFunc
       lua_rawget (L, -2);  // Stack: mt, pg, getter | nil
       lua_remove (L, -2); // Stack: mt, getter | nil
 
-      if (lua_iscfunction (L, -1)) // Stack: mt, getter
+      if (lua_isuserdata (L, -1)) // Stack: mt, getter
       {
-        lua_remove (L, -2);  // Stack: getter
-        lua_pushvalue (L, 1); // Stack: getter, table | userdata
-        lua_call (L, 1, 1); // Stack: value
-        return 1;
+        Accessor const* const getter = static_cast <Accessor const*> (lua_touserdata (L, -1));
+        return getter->thunk (L, getter); // Stack: mt, getter, value
       }
 
       assert (lua_isnil (L, -1)); // Stack: mt, nil
@@ -113,7 +471,17 @@ struct CFunc
 
       if (lua_isnil (L, -1)) // Stack: mt, nil
       {
-        lua_remove (L, -2); // Stack: nil
+        lua_pop (L, 2); // Stack: -
+        if (pushObjectFields (L, 1, false)) // Stack: fields table (ft)
+        {
+          lua_pushvalue (L, 2); // Stack: ft, field name
+          lua_rawget (L, -2); // Stack: ft, field | nil
+          lua_remove (L, -2); // Stack: field | nil
+        }
+        else
+        {
+          lua_pushnil (L); // Stack: nil
+        }
         return 1;
       }
 
@@ -125,6 +493,81 @@ struct CFunc
     // no return
   }
 
+  //----------------------------------------------------------------------------
+  /**
+      Determine if the class of the object at the index, or one of its base
+      classes, allows objects to have their own fields.
+  */
+  static bool hasObjectFields (lua_State* L, int index)
+  {
+    if (lua_type (L, index) != LUA_TUSERDATA || !getObjectMetatable (L, index))
+      return false;
+
+    for (;;) // Stack: mt
+    {
+      lua_rawgetp (L, -1, getObjectFieldsKey ()); // Stack: mt, true | nil
+      bool const hasFields = lua_toboolean (L, -1) != 0;
+      lua_pop (L, 1); // Stack: mt
+
+      lua_rawgetp (L, -1, getParentKey ()); // Stack: mt, parent mt | nil
+      lua_remove (L, -2); // Stack: parent mt | nil
+      if (hasFields || lua_isnil (L, -1))
+      {
+        lua_pop (L, 1); // Stack: -
+        return hasFields;
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+      Push the table of the fields of the object at the index, kept in its
+      uservalue (its environment with Lua 5.1).
+
+      Returns false and pushes nothing if the class of the object does not
+      allow fields, or if the object has no fields table and create is false.
+  */
+  static bool pushObjectFields (lua_State* L, int index, bool create)
+  {
+    if (!hasObjectFields (L, index))
+      return false;
+
+    index = lua_absindex (L, index);
+
+#if LUA_VERSION_NUM < 502
+    // A userdata always has an environment, so ours is marked.
+    lua_getfenv (L, index); // Stack: env
+    lua_rawgetp (L, -1, getObjectFieldsKey ()); // Stack: env, true | nil
+    bool const exists = lua_toboolean (L, -1) != 0;
+    lua_pop (L, 2); // Stack: -
+    if (exists)
+    {
+      lua_getfenv (L, index); // Stack: fields table (ft)
+      return true;
+    }
+#else
+    lua_getuservalue (L, index); // Stack: fields table (ft) | nil
+    if (lua_istable (L, -1))
+      return true;
+    lua_pop (L, 1); // Stack: -
+#endif
+
+    if (!create)
+      return false;
+
+    lua_newtable (L); // Stack: ft
+#if LUA_VERSION_NUM < 502
+    lua_pushboolean (L, 1); // Stack: ft, true
+    lua_rawsetp (L, -2, getObjectFieldsKey ()); // ft [objectFieldsKey] = true. Stack: ft
+    lua_pushvalue (L, -1); // Stack: ft, ft
+    lua_setfenv (L, index); // Stack: ft
+#else
+    lua_pushvalue (L, -1); // Stack: ft, ft
+    lua_setuservalue (L, index); // Stack: ft
+#endif
+    return true;
+  }
+
   //----------------------------------------------------------------------------
   /**
       __newindex metamethod for namespace or class static members.
@@ -132,7 +575,7 @@ struct CFunc
   */
   static int newindexStaticMetaMethod (lua_State* L)
   {
-    return newindexMetaMethod (L, false);
+    return newindexMetaMethod (L);
   }
 
   //----------------------------------------------------------------------------
@@ -142,14 +585,14 @@ struct CFunc
   */
   static int newindexObjectMetaMethod (lua_State* L)
   {
-    return newindexMetaMethod (L, true);
+    return newindexMetaMethod (L);
   }
 
-  static int newindexMetaMethod (lua_State* L, bool pushSelf)
+  static int newindexMetaMethod (lua_State* L)
   {
     assert (lua_istable (L, 1) || lua_isuserdata (L, 1)); // Stack (further not shown): table | userdata, name, new value
 
-    lua_getmetatable (L, 1); // Stack: metatable (mt)
+    getObjectMetatable (L, 1); // Stack: metatable (mt)
     assert (lua_istable (L, -1));
 
     for (;;)
@@ -168,15 +611,10 @@ struct CFunc
       lua_rawget (L, -2); // Stack: mt, ps, setter | nil
       lua_remove (L, -2); // Stack: mt, setter | nil
 
-      if (lua_iscfunction (L, -1)) // Stack: mt, setter
+      if (lua_isuserdata (L, -1)) // Stack: mt, setter
       {
-        lua_remove (L, -2); // Stack: setter
-        if (pushSelf)
-        {
-          lua_pushvalue (L, 1); // Stack: setter, table | userdata
-        }
-        lua_pushvalue (L, 3); // Stack: setter, table | userdata, new value
-        lua_call (L, pushSelf ? 2 : 1, 0); // Stack: -
+        Accessor const* const setter = static_cast <Accessor const*> (lua_touserdata (L, -1));
+        setter->thunk (L, setter);
         return 0;
       }
 
@@ -187,7 +625,15 @@ struct CFunc
 
       if (lua_isnil (L, -1)) // Stack: mt, nil
       {
-        lua_pop (L, 1); // Stack: -
+        lua_pop (L, 2); // Stack: -
+        if (pushObjectFields (L, 1, true)) // Stack: fields table (ft)
+        {
+          lua_pushvalue (L, 2); // Stack: ft, field name
+          lua_pushvalue (L, 3); // Stack: ft, field name, new value
+          lua_rawset (L, -3); // ft [field name] = new value. Stack: ft
+          lua_pop (L, 1); // Stack: -
+          return 0;
+        }
         return luaL_error (L, "No writable member '%s'", lua_tostring (L, 2));
       }
 
@@ -201,32 +647,31 @@ struct CFunc
 
   //----------------------------------------------------------------------------
   /**
-      lua_CFunction to report an error writing to a read-only value.
+      Accessor to report an error writing to a read-only value.
 
-      The name of the variable is in the first upvalue.
+      The name of the variable is the key being written.
   */
-  static int readOnlyError (lua_State* L)
+  static int readOnlyError (lua_State* L, Accessor const*)
   {
     std::string s;
 
-    s = s + "'" + lua_tostring (L, lua_upvalueindex (1)) + "' is read-only";
+    s = s + "'" + lua_tostring (L, 2) + "' is read-only";
 
     return luaL_error (L, s.c_str ());
   }
 
   //----------------------------------------------------------------------------
   /**
-      lua_CFunction to get a variable.
+      Accessor to get a variable.
 
       This is used for global variables or class static data members.
 
-      The pointer to the data is in the first upvalue.
+      The accessor holds the pointer to the data.
   */
   template <class T>
-  static int getVariable (lua_State* L)
+  static int getVariable (lua_State* L, Accessor const* accessor)
   {
-    assert (lua_islightuserdata (L, lua_upvalueindex (1)));
-    T const* ptr = static_cast <T const*> (lua_touserdata (L, lua_upvalueindex (1)));
+    T const* ptr = accessorData <T*> (accessor);
     assert (ptr != 0);
     Stack <T>::push (L, *ptr);
     return 1;
@@ -234,19 +679,66 @@ struct CFunc
 
   //----------------------------------------------------------------------------
   /**
-      lua_CFunction to set a variable.
+      Accessor to set a variable.
 
       This is used for global variables or class static data members.
 
-      The pointer to the data is in the first upvalue.
+      The accessor holds the pointer to the data.
   */
   template <class T>
-  static int setVariable (lua_State* L)
+  static int setVariable (lua_State* L, Accessor const* accessor)
   {
-    assert (lua_islightuserdata (L, lua_upvalueindex (1)));
-    T* ptr = static_cast <T*> (lua_touserdata (L, lua_upvalueindex (1)));
+    T* ptr = accessorData <T*> (accessor);
     assert (ptr != 0);
-    *ptr = Stack <T>::get (L, 1);
+    *ptr = Stack <T>::get (L, 3);
+    return 0;
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+      Accessor to call a property get function.
+
+      This is used for global properties and class static properties.
+
+      The accessor holds the function pointer.
+  */
+  template <class R>
+  static int callGetter (lua_State* L, Accessor const* accessor)
+  {
+    R (*get) () = accessorData <R (*) ()> (accessor);
+    assert (get != 0);
+    try
+    {
+      Stack <R>::push (L, get ());
+    }
+    catch (const std::exception& e)
+    {
+      luaL_error (L, e.what ());
+    }
+    return 1;
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+      Accessor to call a property set function.
+
+      This is used for global properties and class static properties.
+
+      The accessor holds the function pointer.
+  */
+  template <class A>
+  static int callSetter (lua_State* L, Accessor const* accessor)
+  {
+    void (*set) (A) = accessorData <void (*) (A)> (accessor);
+    assert (set != 0);
+    try
+    {
+      set (Stack <A>::get (L, 3));
+    }
+    catch (const std::exception& e)
+    {
+      luaL_error (L, e.what ());
+    }
     return 0;
   }
 
@@ -264,20 +756,19 @@ struct CFunc
     struct Call
   {
     typedef typename FuncTraits <FnPtr>::Params Params;
+
     static int f (lua_State* L)
     {
       assert (isfulluserdata (L, lua_upvalueindex (1)));
       FnPtr const& fnptr = *static_cast <FnPtr const*> (lua_touserdata (L, lua_upvalueindex (1)));
       assert (fnptr != 0);
-      try
-      {
-        ArgList <Params> args (L);
-        Stack <typename FuncTraits <FnPtr>::ReturnType>::push (L, FuncTraits <FnPtr>::call (fnptr, args));
-      }
-      catch (const std::exception& e)
-      {
-        luaL_error (L, e.what ());
-      }
+      return CallGuard::call <Call> (L, fnptr);
+    }
+
+    static int invoke (lua_State* L, FnPtr fnptr)
+    {
+      ArgList <Params> args (L);
+      Stack <ReturnType>::push (L, FuncTraits <FnPtr>::call (fnptr, args));
       return 1;
     }
   };
@@ -295,20 +786,19 @@ struct CFunc
   struct Call <FnPtr, void>
   {
     typedef typename FuncTraits <FnPtr>::Params Params;
+
     static int f (lua_State* L)
     {
       assert (isfulluserdata (L, lua_upvalueindex (1)));
       FnPtr const& fnptr = *static_cast <FnPtr const*> (lua_touserdata (L, lua_upvalueindex (1)));
       assert (fnptr != 0);
-      try
-      {
-        ArgList <Params> args (L);
-        FuncTraits <FnPtr>::call (fnptr, args);
-      }
-      catch (const std::exception& e)
-      {
-        luaL_error (L, e.what ());
-      }
+      return CallGuard::call <Call> (L, fnptr);
+    }
+
+    static int invoke (lua_State* L, FnPtr fnptr)
+    {
+      ArgList <Params> args (L);
+      FuncTraits <FnPtr>::call (fnptr, args);
       return 0;
     }
   };
@@ -319,6 +809,9 @@ struct CFunc
 
       The member function pointer is in the first upvalue.
       The class userdata object is at the top of the Lua stack.
+
+      The arguments of invoke () start at the index Start, which is 1 when
+      the object is bound to the closure instead of passed on the stack.
   */
   template <class MemFnPtr,
     class ReturnType = typename FuncTraits <MemFnPtr>::ReturnType>
@@ -331,17 +824,16 @@ struct CFunc
     {
       assert (isfulluserdata (L, lua_upvalueindex (1)));
       T* const t = Userdata::get <T> (L, 1, false);
-      MemFnPtr const& fnptr = *static_cast <MemFnPtr const*> (lua_touserdata (L, lua_upvalueindex (1)));
+      MemFnPtr const& fnptr = static_cast <TypedMethod <MemFnPtr> const*> (lua_touserdata (L, lua_upvalueindex (1)))->data;
       assert (fnptr != 0);
-      try
-      {
-        ArgList <Params, 2> args (L);
-        Stack <ReturnType>::push (L, FuncTraits <MemFnPtr>::call (t, fnptr, args));
-      }
-      catch (const std::exception& e)
-      {
-        luaL_error (L, e.what ());
-      }
+      return CallGuard::call <CallMember> (L, t, fnptr);
+    }
+
+    template <int Start = 2>
+    static int invoke (lua_State* L, T* t, MemFnPtr fnptr)
+    {
+      ArgList <Params, Start> args (L);
+      Stack <ReturnType>::push (L, FuncTraits <MemFnPtr>::call (t, fnptr, args));
       return 1;
     }
   };
@@ -357,17 +849,16 @@ struct CFunc
     {
       assert (isfulluserdata (L, lua_upvalueindex (1)));
       T const* const t = Userdata::get <T> (L, 1, true);
-      MemFnPtr const& fnptr = *static_cast <MemFnPtr const*> (lua_touserdata (L, lua_upvalueindex (1)));
+      MemFnPtr const& fnptr = static_cast <TypedMethod <MemFnPtr> const*> (lua_touserdata (L, lua_upvalueindex (1)))->data;
       assert (fnptr != 0);
-      try
-      {
-        ArgList <Params, 2> args (L);
-        Stack <ReturnType>::push (L, FuncTraits <MemFnPtr>::call (t, fnptr, args));
-      }
-      catch (const std::exception& e)
-      {
-        luaL_error (L, e.what ());
-      }
+      return CallGuard::call <CallConstMember> (L, t, fnptr);
+    }
+
+    template <int Start = 2>
+    static int invoke (lua_State* L, T const* t, MemFnPtr fnptr)
+    {
+      ArgList <Params, Start> args (L);
+      Stack <ReturnType>::push (L, FuncTraits <MemFnPtr>::call (t, fnptr, args));
       return 1;
     }
   };
@@ -389,17 +880,16 @@ struct CFunc
     {
       assert (isfulluserdata (L, lua_upvalueindex (1)));
       T* const t = Userdata::get <T> (L, 1, false);
-      MemFnPtr const& fnptr = *static_cast <MemFnPtr const*> (lua_touserdata (L, lua_upvalueindex (1)));
+      MemFnPtr const& fnptr = static_cast <TypedMethod <MemFnPtr> const*> (lua_touserdata (L, lua_upvalueindex (1)))->data;
       assert (fnptr != 0);
-      try
-      {
-        ArgList <Params, 2> args (L);
-        FuncTraits <MemFnPtr>::call (t, fnptr, args);
-      }
-      catch (const std::exception& e)
-      {
-        luaL_error (L, e.what ());
-      }
+      return CallGuard::call <CallMember> (L, t, fnptr);
+    }
+
+    template <int Start = 2>
+    static int invoke (lua_State* L, T* t, MemFnPtr fnptr)
+    {
+      ArgList <Params, Start> args (L);
+      FuncTraits <MemFnPtr>::call (t, fnptr, args);
       return 0;
     }
   };
@@ -414,17 +904,16 @@ struct CFunc
     {
       assert (isfulluserdata (L, lua_upvalueindex (1)));
       T const* const t = Userdata::get <T> (L, 1, true);
-      MemFnPtr const& fnptr = *static_cast <MemFnPtr const*> (lua_touserdata (L, lua_upvalueindex (1)));
+      MemFnPtr const& fnptr = static_cast <TypedMethod <MemFnPtr> const*> (lua_touserdata (L, lua_upvalueindex (1)))->data;
       assert (fnptr != 0);
-      try
-      {
-        ArgList <Params, 2> args (L);
-        FuncTraits <MemFnPtr>::call (t, fnptr, args);
-      }
-      catch (const std::exception& e)
-      {
-        luaL_error (L, e.what ());
-      }
+      return CallGuard::call <CallConstMember> (L, t, fnptr);
+    }
+
+    template <int Start = 2>
+    static int invoke (lua_State* L, T const* t, MemFnPtr fnptr)
+    {
+      ArgList <Params, Start> args (L);
+      FuncTraits <MemFnPtr>::call (t, fnptr, args);
       return 0;
     }
   };
@@ -464,6 +953,528 @@ struct CFunc
     }
   };
 
+#ifdef LUABRIDGE_CXX17
+
+  //----------------------------------------------------------------------------
+  /**
+      lua_CFunction to call a function known at compile time, with a return
+      value.
+
+      This is used for global functions and class static methods. The function
+      is a template argument, so no upvalue is needed and the compiler can
+      inline it.
+  */
+  template <auto fp,
+    class ReturnType = typename FuncTraits <decltype (fp)>::ReturnType>
+  struct InlineCall
+  {
+    typedef typename FuncTraits <decltype (fp)>::Params Params;
+
+    static int f (lua_State* L)
+    {
+      return CallGuard::call <InlineCall> (L);
+    }
+
+    static int invoke (lua_State* L)
+    {
+      ArgList <Params> args (L);
+      Stack <ReturnType>::push (L, FuncTraits <decltype (fp)>::call (fp, args));
+      return 1;
+    }
+  };
+
+  //----------------------------------------------------------------------------
+  /**
+      lua_CFunction to call a function known at compile time, with no return
+      value.
+  */
+  template <auto fp>
+  struct InlineCall <fp, void>
+  {
+    typedef typename FuncTraits <decltype (fp)>::Params Params;
+
+    static int f (lua_State* L)
+    {
+      return CallGuard::call <InlineCall> (L);
+    }
+
+    static int invoke (lua_State* L)
+    {
+      ArgList <Params> args (L);
+      FuncTraits <decltype (fp)>::call (fp, args);
+      return 0;
+    }
+  };
+
+  //----------------------------------------------------------------------------
+  /**
+      lua_CFunction to call a class member function known at compile time,
+      with a return value.
+
+      The class userdata object is at the top of the Lua stack.
+  */
+  template <auto mfp,
+    class ReturnType = typename FuncTraits <decltype (mfp)>::ReturnType>
+  struct InlineCallMember
+  {
+    typedef typename FuncTraits <decltype (mfp)>::ClassType T;
+    typedef typename FuncTraits <decltype (mfp)>::Params Params;
+
+    static int f (lua_State* L)
+    {
+      T* const t = Userdata::get <T> (L, 1, false);
+      return CallGuard::call <InlineCallMember> (L, t);
+    }
+
+    template <int Start = 2>
+    static int invoke (lua_State* L, T* t)
+    {
+      ArgList <Params, Start> args (L);
+      Stack <ReturnType>::push (L, FuncTraits <decltype (mfp)>::call (t, mfp, args));
+      return 1;
+    }
+  };
+
+  template <auto mfp,
+    class ReturnType = typename FuncTraits <decltype (mfp)>::ReturnType>
+  struct InlineCallConstMember
+  {
+    typedef typename FuncTraits <decltype (mfp)>::ClassType T;
+    typedef typename FuncTraits <decltype (mfp)>::Params Params;
+
+    static int f (lua_State* L)
+    {
+      T const* const t = Userdata::get <T> (L, 1, true);
+      return CallGuard::call <InlineCallConstMember> (L, t);
+    }
+
+    template <int Start = 2>
+    static int invoke (lua_State* L, T const* t)
+    {
+      ArgList <Params, Start> args (L);
+      Stack <ReturnType>::push (L, FuncTraits <decltype (mfp)>::call (t, mfp, args));
+      return 1;
+    }
+  };
+
+  //----------------------------------------------------------------------------
+  /**
+      lua_CFunction to call a class member function known at compile time,
+      with no return value.
+
+      The class userdata object is at the top of the Lua stack.
+  */
+  template <auto mfp>
+  struct InlineCallMember <mfp, void>
+  {
+    typedef typename FuncTraits <decltype (mfp)>::ClassType T;
+    typedef typename FuncTraits <decltype (mfp)>::Params Params;
+
+    static int f (lua_State* L)
+    {
+      T* const t = Userdata::get <T> (L, 1, false);
+      return CallGuard::call <InlineCallMember> (L, t);
+    }
+
+    template <int Start = 2>
+    static int invoke (lua_State* L, T* t)
+    {
+      ArgList <Params, Start> args (L);
+      FuncTraits <decltype (mfp)>::call (t, mfp, args);
+      return 0;
+    }
+  };
+
+  template <auto mfp>
+  struct InlineCallConstMember <mfp, void>
+  {
+    typedef typename FuncTraits <decltype (mfp)>::ClassType T;
+    typedef typename FuncTraits <decltype (mfp)>::Params Params;
+
+    static int f (lua_State* L)
+    {
+      T const* const t = Userdata::get <T> (L, 1, true);
+      return CallGuard::call <InlineCallConstMember> (L, t);
+    }
+
+    template <int Start = 2>
+    static int invoke (lua_State* L, T const* t)
+    {
+      ArgList <Params, Start> args (L);
+      FuncTraits <decltype (mfp)>::call (t, mfp, args);
+      return 0;
+    }
+  };
+
+#endif // LUABRIDGE_CXX17
+
+  //--------------------------------------------------------------------------
+
+  //----------------------------------------------------------------------------
+  /**
+      Push the pointer to the object a closure is bound to, or false for a
+      handle, which is resolved on each call by getBoundObject ().
+  */
+  static void pushBoundPointer (lua_State* L, int objectIndex, void const* p)
+  {
+    if (Userdata::isHandle (L, objectIndex))
+      lua_pushboolean (L, 0);
+    else
+      lua_pushlightuserdata (L, const_cast <void*> (p));
+  }
+
+  /**
+      Get the object a closure is bound to from its upvalues. A handle to a
+      destroyed object raises a Lua error.
+  */
+  template <class Object>
+  static Object* getBoundObject (lua_State* L, int objectUpvalue, int pointerUpvalue)
+  {
+    void* p = lua_touserdata (L, lua_upvalueindex (pointerUpvalue));
+    if (p == 0)
+    {
+      p = Userdata::getPointer (L, lua_upvalueindex (objectUpvalue));
+      if (p == 0)
+        luaL_error (L, "the object was destroyed");
+    }
+    return static_cast <Object*> (p);
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+      Creates and calls member functions bound to an object.
+
+      The object is validated once, and the bound closure holds the member
+      function pointer upvalue of the method, the object and the pointer to
+      it, so calls only convert the arguments. Handles are resolved on each
+      call instead, as their object may be destroyed.
+  */
+  template <class MemFnPtr, bool isConst>
+  struct BoundMember
+  {
+    typedef typename FuncTraits <MemFnPtr>::ClassType T;
+    typedef typename std::conditional <isConst, T const, T>::type Object;
+    typedef typename std::conditional <isConst,
+      CallConstMember <MemFnPtr>, CallMember <MemFnPtr> >::type Thunk;
+
+    static int bind (lua_State* L, int methodIndex)
+    {
+      Object* const t = Userdata::get <T> (L, 1, isConst);
+      if (t == 0)
+        return luaL_argerror (L, 1, "nil object");
+
+      lua_getupvalue (L, methodIndex, 1); // Stack: object, ..., function ptr
+      assert (isfulluserdata (L, -1));
+      lua_pushvalue (L, 1); // Stack: object, ..., function ptr, object
+      pushBoundPointer (L, 1, t); // Stack: object, ..., function ptr, object, pointer | false
+      lua_pushcclosure (L, &f, 3); // Stack: object, ..., bound function
+      return 1;
+    }
+
+    static int f (lua_State* L)
+    {
+      assert (isfulluserdata (L, lua_upvalueindex (1)));
+      MemFnPtr const& fnptr = static_cast <TypedMethod <MemFnPtr> const*> (lua_touserdata (L, lua_upvalueindex (1)))->data;
+      Object* const t = getBoundObject <Object> (L, 2, 3);
+      return CallGuard::call <BoundMember> (L, t, fnptr);
+    }
+
+    static int invoke (lua_State* L, Object* t, MemFnPtr fnptr)
+    {
+      return Thunk::template invoke <1> (L, t, fnptr);
+    }
+  };
+
+  //----------------------------------------------------------------------------
+  /**
+      Calls a member function on each object of the array at index 1. The
+      arguments from index 3 are read once and shared by the calls, the
+      results are discarded.
+
+      The member function pointer is copied, as a call may replace the
+      method and let its upvalue be collected.
+  */
+  template <class MemFnPtr, bool isConst>
+  struct CallEachMember
+  {
+    static int f (lua_State* L, Method const* method)
+    {
+      MemFnPtr const fnptr = static_cast <TypedMethod <MemFnPtr> const*> (method)->data;
+      assert (fnptr != 0);
+      return CallGuard::call <CallEachMember> (L, fnptr);
+    }
+
+    static int invoke (lua_State* L, MemFnPtr fnptr)
+    {
+      return callOnEach <MemFnPtr> (L, fnptr, isConst);
+    }
+  };
+
+  template <class MemFnPtr, class MemFn>
+  static int callOnEach (lua_State* L, MemFn const& fn, bool isConst)
+  {
+    typedef typename FuncTraits <MemFnPtr>::ClassType T;
+    typedef typename FuncTraits <MemFnPtr>::ReturnType R;
+    typedef typename FuncTraits <MemFnPtr>::Params Params;
+
+    ArgList <Params, 3> args (L);
+    if (lua_islightuserdata (L, 1))
+    {
+      ObjectRange* const objects = static_cast <ObjectRange*> (lua_touserdata (L, 1));
+      void const* object = 0;
+      for (int i = 1; objects->next (objects, &object); ++i)
+      {
+        if (object == 0)
+          luaL_error (L, "bad element #%d (null pointer)", i);
+        Invoke <R, Params>::callShared (
+          static_cast <T*> (const_cast <void*> (object)), fn, args);
+      }
+      return 0;
+    }
+
+    int const n = get_length (L, 1);
+    for (int i = 1; i <= n; ++i)
+      Invoke <R, Params>::callShared (getEachObject <T> (L, i, isConst), fn, args);
+    return 0;
+  }
+
+  /**
+      Get the object at index i of the array at index 1, checking its class.
+  */
+  template <class T>
+  static T* getEachObject (lua_State* L, int i, bool canBeConst)
+  {
+    lua_rawgeti (L, 1, i); // Stack: ..., object
+    T* const t = Userdata::find <T> (L, -1, canBeConst);
+    if (t == 0)
+    {
+      lua_rawgetp (L, LUA_REGISTRYINDEX, canBeConst ?
+        ClassInfo <T>::getConstKey () : ClassInfo <T>::getClassKey ()); // Stack: ..., object, mt
+      lua_rawgetp (L, -1, getTypeKey ()); // Stack: ..., object, mt, type name
+      luaL_error (L, "bad element #%d (%s expected, got %s)",
+        i, lua_tostring (L, -1), luaL_typename (L, -3));
+    }
+    lua_pop (L, 1); // Stack: ...
+    return t;
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+      Push the method kinds table, creating it on first use.
+
+      It maps the lua_CFunction of each method without upvalues to its kind,
+      and it is the metatable of the Method upvalue of the other methods.
+  */
+  static void pushMethodKinds (lua_State* L)
+  {
+    lua_rawgetp (L, LUA_REGISTRYINDEX, getMethodKindsKey ()); // Stack: kinds table (kt) | nil
+    if (lua_isnil (L, -1))
+    {
+      lua_pop (L, 1); // Stack: -
+      lua_newtable (L); // Stack: kt
+      lua_pushvalue (L, -1); // Stack: kt, kt
+      lua_rawsetp (L, LUA_REGISTRYINDEX, getMethodKindsKey ()); // Stack: kt
+    }
+  }
+
+  /**
+      Push the upvalue of a method calling a member function pointer.
+  */
+  template <class MemFnPtr>
+  static void pushMethodData (lua_State* L, MemFnPtr mf, MethodKind const* kind)
+  {
+    new (lua_newuserdata (L, sizeof (TypedMethod <MemFnPtr>)))
+      TypedMethod <MemFnPtr> (kind, mf); // Stack: method data (md)
+    pushMethodKinds (L); // Stack: md, kinds table (kt)
+    lua_setmetatable (L, -2); // Stack: md
+  }
+
+  /**
+      Remember the kind of a method without upvalues.
+  */
+  static void addMethodKind (lua_State* L, lua_CFunction method, MethodKind const* kind)
+  {
+    pushMethodKinds (L); // Stack: kinds table (kt)
+    lua_pushlightuserdata (L, const_cast <MethodKind*> (kind)); // Stack: kt, kind
+    lua_rawsetp (L, -2, reinterpret_cast <void*> (method)); // kt [method] = kind. Stack: kt
+    lua_pop (L, 1); // Stack: -
+  }
+
+  /**
+      Get the kind of the method at the index, or null if it is not a member
+      function registered with addFunction, like an overload set.
+  */
+  static MethodKind const* getMethodKind (lua_State* L, int index)
+  {
+    lua_CFunction const method = lua_tocfunction (L, index);
+    if (method == 0)
+      return 0;
+
+    index = lua_absindex (L, index);
+    MethodKind const* kind = 0;
+    pushMethodKinds (L); // Stack: kinds table (kt)
+    if (lua_getupvalue (L, index, 1) != 0) // Stack: kt, upvalue
+    {
+      if (lua_getmetatable (L, -1)) // Stack: kt, upvalue, mt
+      {
+        if (lua_rawequal (L, -1, -3))
+          kind = static_cast <Method const*> (lua_touserdata (L, -2))->kind;
+        lua_pop (L, 1); // Stack: kt, upvalue
+      }
+    }
+    else
+    {
+      lua_rawgetp (L, -1, reinterpret_cast <void*> (method)); // Stack: kt, kind | nil
+      kind = static_cast <MethodKind const*> (lua_touserdata (L, -1));
+    }
+    lua_pop (L, 2); // Stack: -
+    return kind;
+  }
+
+  /**
+      Push the method named at nameIndex of the class object at objectIndex
+      and return its kind, looking it up like the __index metamethod. Const
+      objects only see const methods.
+
+      Returns null and pushes nothing if there is no such method, or if it
+      is not a member function registered with addFunction, like an overload
+      set.
+  */
+  static MethodKind const* pushMethod (lua_State* L, int objectIndex, int nameIndex)
+  {
+    nameIndex = lua_absindex (L, nameIndex);
+
+    getObjectMetatable (L, objectIndex); // Stack: mt
+    return pushClassMethod (L, nameIndex);
+  }
+
+  /**
+      Push the method named at nameIndex of the class or const table on top
+      of the stack, which is popped, and return its kind.
+  */
+  static MethodKind const* pushClassMethod (lua_State* L, int nameIndex)
+  {
+    for (;;) // Stack: mt
+    {
+      lua_pushvalue (L, nameIndex); // Stack: mt, name
+      lua_rawget (L, -2); // Stack: mt, method | nil
+      if (!lua_isnil (L, -1))
+        break;
+      lua_pop (L, 1); // Stack: mt
+
+      lua_rawgetp (L, -1, getParentKey ()); // Stack: mt, parent mt | nil
+      lua_remove (L, -2); // Stack: parent mt | nil
+      if (lua_isnil (L, -1))
+      {
+        lua_pop (L, 1); // Stack: -
+        return 0;
+      }
+    }
+    lua_remove (L, -2); // Stack: method
+
+    MethodKind const* const kind = getMethodKind (L, -1);
+    if (kind == 0)
+      lua_pop (L, 1); // Stack: -
+    return kind;
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+      Determine if the value at the index is one of our class objects.
+  */
+  static bool isClassObject (lua_State* L, int index)
+  {
+    if (lua_type (L, index) != LUA_TUSERDATA || !lua_getmetatable (L, index))
+      return false;
+
+    lua_rawgetp (L, -1, getIdentityKey ()); // Stack: mt, identity | nil
+    bool const isOurs = lua_isboolean (L, -1);
+    lua_pop (L, 2); // Stack: -
+    return isOurs;
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+      lua_CFunction returning a method of the object at index 1, named at
+      index 2, bound to the object.
+  */
+  static int bindMethod (lua_State* L)
+  {
+    char const* const name = luaL_checkstring (L, 2);
+
+    if (!isClassObject (L, 1))
+      return luaL_argerror (L, 1, "class object expected");
+
+    MethodKind const* const kind = pushMethod (L, 1, 2); // Stack: object, name, method
+    if (kind == 0)
+      return luaL_error (L, "no method named '%s' to bind", name);
+
+    return kind->bind (L, 3); // Stack: object, name, method, bound function
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+      lua_CFunction calling the method named at index 2 on each object of
+      the array at index 1, with the remaining arguments.
+
+      The method is looked up once, from the first object.
+  */
+  static int callEach (lua_State* L)
+  {
+    luaL_checktype (L, 1, LUA_TTABLE);
+    char const* const name = luaL_checkstring (L, 2);
+    int const top = lua_gettop (L);
+
+    lua_rawgeti (L, 1, 1); // Stack: array, name, args..., first object | nil
+    if (lua_isnil (L, -1))
+      return 0;
+
+    if (!isClassObject (L, -1))
+      return luaL_error (L, "bad element #1 (class object expected, got %s)",
+        luaL_typename (L, -1));
+
+    MethodKind const* const kind = pushMethod (L, -1, 2); // Stack: array, name, args..., first object, method
+    if (kind == 0)
+      return luaL_error (L, "no method named '%s' to call on each object", name);
+
+    return callMethodOnEach (L, kind, top);
+  }
+
+  /**
+      lua_CFunction calling the method named at index 2 on each object of
+      the ObjectRange at index 1, with the remaining arguments.
+  */
+  static int callEachInRange (lua_State* L)
+  {
+    assert (lua_islightuserdata (L, 1));
+    ObjectRange const* const objects = static_cast <ObjectRange const*> (lua_touserdata (L, 1));
+    char const* const name = luaL_checkstring (L, 2);
+    int const top = lua_gettop (L);
+
+    lua_rawgetp (L, LUA_REGISTRYINDEX, objects->classKey); // Stack: range, name, args..., mt | nil
+    if (!lua_istable (L, -1))
+      return luaL_error (L, "the class of the objects is not registered");
+
+    MethodKind const* const kind = pushClassMethod (L, 2); // Stack: range, name, args..., method
+    if (kind == 0)
+      return luaL_error (L, "no method named '%s' to call on each object", name);
+
+    return callMethodOnEach (L, kind, top);
+  }
+
+  /**
+      Call the method on top of the stack, of the kind, on each object of
+      the array or range at index 1 with the arguments up to the top.
+  */
+  static int callMethodOnEach (lua_State* L, MethodKind const* kind, int top)
+  {
+    Method const* method = 0;
+    if (lua_getupvalue (L, -1, 1) != 0) // Stack: ..., method, method data
+      method = static_cast <Method const*> (lua_touserdata (L, -1));
+    lua_settop (L, top); // Stack: array | range, name, args...
+    return kind->callEach (L, method);
+  }
+
   //--------------------------------------------------------------------------
 
   // SFINAE Helpers
@@ -473,7 +1484,9 @@ struct CFunc
   {
     static void add (lua_State* L, char const* name, MemFnPtr mf)
     {
-      new (lua_newuserdata (L, sizeof (MemFnPtr))) MemFnPtr (mf);
+      static MethodKind const kind = {
+        &BoundMember <MemFnPtr, true>::bind, &CallEachMember <MemFnPtr, true>::f };
+      pushMethodData (L, mf, &kind);
       lua_pushcclosure (L, &CallConstMember <MemFnPtr>::f, 1);
       lua_pushvalue (L, -1);
       rawsetfield (L, -5, name); // const table
@@ -486,12 +1499,231 @@ struct CFunc
   {
     static void add (lua_State* L, char const* name, MemFnPtr mf)
     {
-      new (lua_newuserdata (L, sizeof (MemFnPtr))) MemFnPtr (mf);
+      static MethodKind const kind = {
+        &BoundMember <MemFnPtr, false>::bind, &CallEachMember <MemFnPtr, false>::f };
+      pushMethodData (L, mf, &kind);
       lua_pushcclosure (L, &CallMember <MemFnPtr>::f, 1);
       rawsetfield (L, -3, name); // class table
     }
   };
 
+  //----------------------------------------------------------------------------
+  /**
+      An overload of a global function or a class static method.
+  */
+  template <class FnPtr>
+  struct CallOverload
+  {
+    typedef typename FuncTraits <FnPtr>::Params Params;
+
+    static bool match (lua_State* L)
+    {
+      return ArgList <Params>::matches (L);
+    }
+
+    static int invoke (lua_State* L, Overload const* overload)
+    {
+      FnPtr const& fnptr = static_cast <TypedOverload <FnPtr> const*> (overload)->data;
+      return CallGuard::call <Call <FnPtr> > (L, fnptr);
+    }
+  };
+
+  /**
+      An overload of a class member function.
+
+      The class userdata object is at the top of the Lua stack. It may only
+      be const if the member function is const.
+  */
+  template <class MemFnPtr>
+  struct CallMemberOverload
+  {
+    typedef typename FuncTraits <MemFnPtr>::ClassType T;
+    typedef typename FuncTraits <MemFnPtr>::Params Params;
+    static bool const isConst = FuncTraits <MemFnPtr>::isConstMemberFunction;
+    typedef typename std::conditional <isConst, T const, T>::type Object;
+    typedef typename std::conditional <isConst,
+      CallConstMember <MemFnPtr>, CallMember <MemFnPtr> >::type Thunk;
+
+    static bool match (lua_State* L)
+    {
+      return Userdata::isInstance <T> (L, 1, isConst) && ArgList <Params, 2>::matches (L);
+    }
+
+    static int invoke (lua_State* L, Overload const* overload)
+    {
+      MemFnPtr const& fnptr = static_cast <TypedOverload <MemFnPtr> const*> (overload)->data;
+      Object* const t = Userdata::get <T> (L, 1, isConst);
+      return CallGuard::call <Thunk> (L, t, fnptr);
+    }
+  };
+
+  //----------------------------------------------------------------------------
+  /**
+      Push a closure which calls the first of the overloads matching the
+      types of the arguments.
+
+      Kind is CallOverload or CallMemberOverload.
+  */
+  template <template <class> class Kind, class... FnPtrs>
+  static void pushOverloads (lua_State* L, FnPtrs... fnptrs)
+  {
+    int const count = int (sizeof... (FnPtrs));
+    new (lua_newuserdata (L, sizeof (OverloadSet))) OverloadSet (count);
+    int const pushed [] = { (pushOverload <Kind <FnPtrs> > (L, fnptrs), 0)... };
+    (void) pushed;
+    lua_pushcclosure (L, &callOverloads, 1 + count);
+  }
+
+  template <class Kind, class FnPtr>
+  static void pushOverload (lua_State* L, FnPtr fnptr)
+  {
+    new (lua_newuserdata (L, sizeof (TypedOverload <FnPtr>)))
+      TypedOverload <FnPtr> (&Kind::match, &Kind::invoke, fnptr);
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+      lua_CFunction to call a function of an overload set.
+
+      The overload set is in the first upvalue, the overloads are in the
+      following upvalues. The chosen overload is cached by the signature of
+      the arguments.
+  */
+  static int callOverloads (lua_State* L)
+  {
+    assert (isfulluserdata (L, lua_upvalueindex (1)));
+    OverloadSet* const set = static_cast <OverloadSet*> (lua_touserdata (L, lua_upvalueindex (1)));
+
+    OverloadSignature signature;
+    bool const isCacheable = signature.read (L);
+
+    int index = isCacheable ? set->find (signature) : 0;
+    if (index == 0)
+    {
+      for (int i = 2; i <= set->count + 1 && index == 0; ++i)
+      {
+        Overload const* const overload = static_cast <Overload const*> (
+          lua_touserdata (L, lua_upvalueindex (i)));
+        if (overload->match (L))
+          index = i;
+      }
+
+      if (index == 0)
+        return noMatchingOverload (L);
+
+      if (isCacheable)
+        set->insert (signature, index);
+    }
+
+    Overload const* const overload = static_cast <Overload const*> (
+      lua_touserdata (L, lua_upvalueindex (index)));
+    return overload->invoke (L, overload);
+  }
+
+  static int noMatchingOverload (lua_State* L)
+  {
+    int const count = lua_gettop (L);
+    lua_pushliteral (L, "no matching overload for the arguments (");
+    for (int i = 1; i <= count; ++i)
+    {
+      if (i > 1)
+        lua_pushliteral (L, ", ");
+      lua_pushstring (L, luaL_typename (L, i));
+    }
+    lua_pushliteral (L, ")");
+    lua_concat (L, lua_gettop (L) - count);
+    return lua_error (L);
+  }
+
+#ifdef LUABRIDGE_CXX17
+
+  /**
+      Creates and calls member functions known at compile time bound to an
+      object. The bound closure holds the object and the pointer to it, or
+      false for a handle.
+  */
+  template <auto mfp, bool isConst>
+  struct BoundInlineMember
+  {
+    typedef typename FuncTraits <decltype (mfp)>::ClassType T;
+    typedef typename std::conditional <isConst, T const, T>::type Object;
+    typedef typename std::conditional <isConst,
+      InlineCallConstMember <mfp>, InlineCallMember <mfp> >::type Thunk;
+
+    static int bind (lua_State* L, int)
+    {
+      Object* const t = Userdata::get <T> (L, 1, isConst);
+      if (t == 0)
+        return luaL_argerror (L, 1, "nil object");
+
+      lua_pushvalue (L, 1); // Stack: object, ..., object
+      pushBoundPointer (L, 1, t); // Stack: object, ..., object, pointer | false
+      lua_pushcclosure (L, &f, 2); // Stack: object, ..., bound function
+      return 1;
+    }
+
+    static int f (lua_State* L)
+    {
+      Object* const t = getBoundObject <Object> (L, 1, 2);
+      return CallGuard::call <BoundInlineMember> (L, t);
+    }
+
+    static int invoke (lua_State* L, Object* t)
+    {
+      return Thunk::template invoke <1> (L, t);
+    }
+  };
+
+  /**
+      Calls a member function known at compile time on each object of the
+      array at index 1.
+  */
+  template <auto mfp, bool isConst>
+  struct InlineCallEachMember
+  {
+    static int f (lua_State* L, Method const*)
+    {
+      return CallGuard::call <InlineCallEachMember> (L);
+    }
+
+    static int invoke (lua_State* L)
+    {
+      return callOnEach <decltype (mfp)> (L, mfp, isConst);
+    }
+  };
+
+  template <auto mfp, bool isConst>
+  struct InlineCallMemberFunctionHelper
+  {
+    static void add (lua_State* L, char const* name)
+    {
+      static MethodKind const kind = {
+        &BoundInlineMember <mfp, true>::bind, &InlineCallEachMember <mfp, true>::f };
+      addMethodKind (L, &InlineCallConstMember <mfp>::f, &kind);
+
+      lua_pushcfunction (L, &InlineCallConstMember <mfp>::f);
+      lua_pushvalue (L, -1);
+      rawsetfield (L, -5, name); // const table
+      rawsetfield (L, -3, name); // class table
+    }
+  };
+
+  template <auto mfp>
+  struct InlineCallMemberFunctionHelper <mfp, false>
+  {
+    static void add (lua_State* L, char const* name)
+    {
+      static MethodKind const kind = {
+        &BoundInlineMember <mfp, false>::bind, &InlineCallEachMember <mfp, false>::f };
+      addMethodKind (L, &InlineCallMember <mfp>::f, &kind);
+
+      lua_pushcfunction (L, &InlineCallMember <mfp>::f);
+      rawsetfield (L, -3, name); // class table
+    }
+  };
+
+#endif // LUABRIDGE_CXX17
+
   //--------------------------------------------------------------------------
   /**
       __gc metamethod for a class.
@@ -500,26 +1732,25 @@ struct CFunc
   static int gcMetaMethod (lua_State* L)
   {
     Userdata* const ud = Userdata::getExact <C> (L, 1);
-    lua_getmetatable (L, 1);
-    ud->~Userdata ();
+    static_cast <UserdataOwner*> (ud)->destroy ();
     return 0;
   }
 
   //--------------------------------------------------------------------------
   /**
-      lua_CFunction to get a class data member.
+      Accessor to get a class data member.
 
-      The pointer-to-member is in the first upvalue.
-      The class userdata object is at the top of the Lua stack.
+      The accessor holds the pointer-to-member.
+      The class userdata object is at index 1 of the Lua stack.
   */
   template <class C, typename T>
-  static int getProperty (lua_State* L)
+  static int getProperty (lua_State* L, Accessor const* accessor)
   {
     C* const c = Userdata::get <C> (L, 1, true);
-    T C::** mp = static_cast <T C::**> (lua_touserdata (L, lua_upvalueindex (1)));
+    T C::* mp = accessorData <T C::*> (accessor);
     try
     {
-      Stack <T&>::push (L, c->**mp);
+      Stack <T&>::push (L, c->*mp);
     }
     catch (const std::exception& e)
     {
@@ -530,19 +1761,118 @@ struct CFunc
 
   //--------------------------------------------------------------------------
   /**
-      lua_CFunction to set a class data member.
+      Accessor to set a class data member.
 
-      The pointer-to-member is in the first upvalue.
-      The class userdata object is at the top of the Lua stack.
+      The accessor holds the pointer-to-member.
+      The class userdata object is at index 1 of the Lua stack.
   */
   template <class C, typename T>
-  static int setProperty (lua_State* L)
+  static int setProperty (lua_State* L, Accessor const* accessor)
+  {
+    C* const c = Userdata::get <C> (L, 1, false);
+    T C::* mp = accessorData <T C::*> (accessor);
+    try
+    {
+      c->*mp = Stack <T>::get (L, 3);
+    }
+    catch (const std::exception& e)
+    {
+      luaL_error (L, e.what ());
+    }
+    return 0;
+  }
+
+  //--------------------------------------------------------------------------
+  /**
+      Accessor to call a class member property get function.
+
+      The accessor holds the member function pointer.
+      The class userdata object is at index 1 of the Lua stack.
+  */
+  template <class C, class R>
+  static int callMemberGetter (lua_State* L, Accessor const* accessor)
+  {
+    typedef R (C::*MFP) () const;
+    C const* const c = Userdata::get <C> (L, 1, true);
+    MFP get = accessorData <MFP> (accessor);
+    assert (get != 0);
+    try
+    {
+      Stack <R>::push (L, (c->*get) ());
+    }
+    catch (const std::exception& e)
+    {
+      luaL_error (L, e.what ());
+    }
+    return 1;
+  }
+
+  //--------------------------------------------------------------------------
+  /**
+      Accessor to call a class member property set function.
+
+      The accessor holds the member function pointer.
+      The class userdata object is at index 1 of the Lua stack.
+  */
+  template <class C, class A>
+  static int callMemberSetter (lua_State* L, Accessor const* accessor)
   {
+    typedef void (C::*MFP) (A);
     C* const c = Userdata::get <C> (L, 1, false);
-    T C::** mp = static_cast <T C::**> (lua_touserdata (L, lua_upvalueindex (1)));
+    MFP set = accessorData <MFP> (accessor);
+    assert (set != 0);
+    try
+    {
+      (c->*set) (Stack <A>::get (L, 3));
+    }
+    catch (const std::exception& e)
+    {
+      luaL_error (L, e.what ());
+    }
+    return 0;
+  }
+
+  //--------------------------------------------------------------------------
+  /**
+      Accessor to call a proxy property get function.
+
+      The accessor holds the function pointer.
+      The class userdata object is at index 1 of the Lua stack.
+  */
+  template <class C, class R>
+  static int callProxyGetter (lua_State* L, Accessor const* accessor)
+  {
+    typedef R (*FP) (C const*);
+    FP get = accessorData <FP> (accessor);
+    assert (get != 0);
+    try
+    {
+      Stack <R>::push (L, get (Stack <C const*>::get (L, 1)));
+    }
+    catch (const std::exception& e)
+    {
+      luaL_error (L, e.what ());
+    }
+    return 1;
+  }
+
+  //--------------------------------------------------------------------------
+  /**
+      Accessor to call a proxy property set function.
+
+      The accessor holds the function pointer.
+      The class userdata object is at index 1 of the Lua stack.
+  */
+  template <class C, class A>
+  static int callProxySetter (lua_State* L, Accessor const* accessor)
+  {
+    typedef void (*FP) (C*, A);
+    FP set = accessorData <FP> (accessor);
+    assert (set != 0);
     try
     {
-      c->**mp = Stack <T>::get (L, 2);
+      C* const c = Stack <C*>::get (L, 1);
+      set (c, Stack <A>::get (L, 3));
     }
     catch (const std::exception& e)
     {
@@ -102,6 +102,131 @@ inline void* getParentKey ()
   return &value;
 }
 
+/**
+ * The key of a table of member names copied from base classes
+ * into a class table, a propget or a propset table.
+ */
+inline void* getFlattenedKey ()
+{
+  static char value;
+  return &value;
+}
+
+/**
+ * The key of a set of derived class static tables in a static table.
+ */
+inline void* getDerivedKey ()
+{
+  static char value;
+  return &value;
+}
+
+/**
+ * The key of a class record in a class or const table.
+ */
+inline void* getClassRecordKey ()
+{
+  static char value;
+  return &value;
+}
+
+/**
+ * The key of the method kinds table in the registry.
+ */
+inline void* getMethodKindsKey ()
+{
+  static char value;
+  return &value;
+}
+
+/**
+ * The key of a weak table of userdata pushed by pointer, indexed by the
+ * object address, in a class or const table.
+ */
+inline void* getPointerCacheKey ()
+{
+  static char value;
+  return &value;
+}
+
+/**
+ * The key of the metatable of objects pushed by pointer, in a class or
+ * const table. Trivially destructible objects stored by value use it too.
+ */
+inline void* getPointerMetatableKey ()
+{
+  static char value;
+  return &value;
+}
+
+/**
+ * The key of the class or const table in a metatable of objects pushed
+ * by pointer.
+ */
+inline void* getObjectTableKey ()
+{
+  static char value;
+  return &value;
+}
+
+/**
+ * The key of the flag allowing objects to have their own fields, in a class
+ * or const table. With Lua 5.1 it also marks the fields table of an object.
+ */
+inline void* getObjectFieldsKey ()
+{
+  static char value;
+  return &value;
+}
+
+/** Type information of a class or const table, kept in C++ memory.
+
+    Each class and const table owns a record linked to the record of the
+    corresponding table of its base class. Objects remember the record of
+    their metatable, so type checks compare keys without touching the Lua
+    stack.
+
+    The record of a table is immediately followed by the record of the
+    handles to its objects, which differs only by the isHandle flag.
+*/
+struct ClassRecord
+{
+  ClassRecord (void const* classKey_,
+               ClassRecord const* parent_,
+               bool isConst_,
+               bool isHandle_ = false)
+    : classKey (classKey_)
+    , parent (parent_)
+    , isConst (isConst_)
+    , isHandle (isHandle_)
+  {
+  }
+
+  /** Determine if the class is, or derives from, the class with the key.
+  */
+  bool isDerivedFrom (void const* baseClassKey) const
+  {
+    for (ClassRecord const* record = this; record != 0; record = record->parent)
+    {
+      if (record->classKey == baseClassKey)
+        return true;
+    }
+    return false;
+  }
+
+  /** Get the record of the handles to objects of the table.
+  */
+  ClassRecord const* getHandleRecord () const
+  {
+    return isHandle ? this : this + 1;
+  }
+
+  void const* const classKey;
+  ClassRecord const* const parent;
+  bool const isConst;
+  bool const isHandle;
+};
+
 /** Unique Lua registry keys for a class.
 
     Each registered class inserts three keys into the registry, whose
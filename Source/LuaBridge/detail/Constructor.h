@@ -29,176 +29,47 @@
 
 #pragma once
 
-namespace luabridge {
 
-/*
-* Constructor generators.  These templates allow you to call operator new and
-* pass the contents of a type/value list to the Constructor.  Like the
-* function pointer containers, these are only defined up to 8 parameters.
-*/
+#include <new>
+
+namespace luabridge {
 
 /** Constructor generators.
 
     These templates call operator new with the contents of a type/value
-    list passed to the Constructor with up to 8 parameters. Two versions
-    of call() are provided. One performs a regular new, the other performs
-    a placement new.
+    list passed to the Constructor. Two versions of call() are provided.
+    One performs a regular new, the other performs a placement new.
 */
-template <class T, typename List>
-struct Constructor {};
+template <class T, class List>
+struct Constructor;
 
-template <class T>
-struct Constructor <T, None>
+template <class T, class... Params>
+struct Constructor <T, TypeList <Params...> >
 {
-  static T* call (TypeListValues <None> const&)
-  {
-    return new T;
-  }
-  static T* call (void* mem, TypeListValues <None> const&)
-  {
-    return new (mem) T;
-  }
-};
+  typedef TypeListValues <TypeList <Params...> > Values;
+  typedef typename MakeIndexSequence <sizeof... (Params)>::Type Indices;
 
-template <class T, class P1>
-struct Constructor <T, TypeList <P1> >
-{
-  static T* call (const TypeListValues<TypeList <P1> > &tvl)
+  static T* call (Values& tvl)
   {
-    return new T(tvl.hd);
+    return call (tvl, Indices ());
   }
-  static T* call (void* mem, const TypeListValues<TypeList <P1> > &tvl)
-  {
-    return new (mem) T(tvl.hd);
-  }
-};
 
-template <class T, class P1, class P2>
-struct Constructor <T, TypeList <P1, TypeList <P2> > >
-{
-  static T* call (const TypeListValues<TypeList <P1, TypeList <P2> > > &tvl)
-  {
-    return new T(tvl.hd, tvl.tl.hd);
-  }
-  static T* call (void* mem, const TypeListValues<TypeList <P1, TypeList <P2> > > &tvl)
+  static T* call (void* mem, Values& tvl)
   {
-    return new (mem) T(tvl.hd, tvl.tl.hd);
+    return call (mem, tvl, Indices ());
   }
-};
 
-template <class T, class P1, class P2, class P3>
-struct Constructor <T, TypeList <P1, TypeList <P2, TypeList <P3> > > >
-{
-  static T* call (const TypeListValues<TypeList <P1, TypeList <P2,
-    TypeList <P3> > > > &tvl)
-  {
-    return new T(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd);
-  }
-  static T* call (void* mem, const TypeListValues<TypeList <P1, TypeList <P2,
-    TypeList <P3> > > > &tvl)
+private:
+  template <std::size_t... I>
+  static T* call (Values& tvl, IndexSequence <I...>)
   {
-    return new (mem) T(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd);
+    return new T (tvl.template get <I> ()...);
   }
-};
 
-template <class T, class P1, class P2, class P3, class P4>
-struct Constructor <T, TypeList <P1, TypeList <P2, TypeList <P3,
-  TypeList <P4> > > > >
-{
-  static T* call (const TypeListValues<TypeList <P1, TypeList <P2,
-    TypeList <P3, TypeList <P4> > > > > &tvl)
-  {
-    return new T(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd);
-  }
-  static T* call (void* mem, const TypeListValues<TypeList <P1, TypeList <P2,
-    TypeList <P3, TypeList <P4> > > > > &tvl)
-  {
-    return new (mem) T(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd);
-  }
-};
-
-template <class T, class P1, class P2, class P3, class P4,
-  class P5>
-struct Constructor <T, TypeList <P1, TypeList <P2, TypeList <P3,
-  TypeList <P4, TypeList <P5> > > > > >
-{
-  static T* call (const TypeListValues<TypeList <P1, TypeList <P2,
-    TypeList <P3, TypeList <P4, TypeList <P5> > > > > > &tvl)
-  {
-    return new T(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd,
-      tvl.tl.tl.tl.tl.hd);
-  }
-  static T* call (void* mem, const TypeListValues<TypeList <P1, TypeList <P2,
-    TypeList <P3, TypeList <P4, TypeList <P5> > > > > > &tvl)
-  {
-    return new (mem) T(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd,
-      tvl.tl.tl.tl.tl.hd);
-  }
-};
-
-template <class T, class P1, class P2, class P3, class P4,
-  class P5, class P6>
-struct Constructor <T, TypeList <P1, TypeList <P2, TypeList <P3,
-  TypeList <P4, TypeList <P5, TypeList <P6> > > > > > >
-{
-  static T* call (const TypeListValues<TypeList <P1, TypeList <P2,
-    TypeList <P3, TypeList <P4, TypeList <P5, TypeList <P6> > > > > > > &tvl)
-  {
-    return new T(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd,
-      tvl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.hd);
-  }
-  static T* call (void* mem, const TypeListValues<TypeList <P1, TypeList <P2,
-    TypeList <P3, TypeList <P4, TypeList <P5, TypeList <P6> > > > > > > &tvl)
-  {
-    return new (mem) T(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd,
-      tvl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.hd);
-  }
-};
-
-template <class T, class P1, class P2, class P3, class P4,
-  class P5, class P6, class P7>
-struct Constructor <T, TypeList <P1, TypeList <P2, TypeList <P3,
-  TypeList <P4, TypeList <P5, TypeList <P6, TypeList <P7> > > > > > > >
-{
-  static T* call (const TypeListValues<TypeList <P1, TypeList <P2,
-    TypeList <P3, TypeList <P4, TypeList <P5, TypeList <P6,
-    TypeList <P7> > > > > > > > &tvl)
-  {
-    return new T(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd,
-      tvl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.hd,
-      tvl.tl.tl.tl.tl.tl.tl.hd);
-  }
-  static T* call (void* mem, const TypeListValues<TypeList <P1, TypeList <P2,
-    TypeList <P3, TypeList <P4, TypeList <P5, TypeList <P6,
-    TypeList <P7> > > > > > > > &tvl)
-  {
-    return new (mem) T(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd,
-      tvl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.hd,
-      tvl.tl.tl.tl.tl.tl.tl.hd);
-  }
-};
-
-template <class T, class P1, class P2, class P3, class P4,
-  class P5, class P6, class P7, class P8>
-struct Constructor <T, TypeList <P1, TypeList <P2, TypeList <P3,
-  TypeList <P4, TypeList <P5, TypeList <P6, TypeList <P7, 
-  TypeList <P8> > > > > > > > >
-{
-  static T* call (const TypeListValues<TypeList <P1, TypeList <P2,
-    TypeList <P3, TypeList <P4, TypeList <P5, TypeList <P6,
-    TypeList <P7, TypeList <P8> > > > > > > > > &tvl)
-  {
-    return new T(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd,
-      tvl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.hd,
-      tvl.tl.tl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.tl.tl.hd);
-  }
-  static T* call (void* mem, const TypeListValues<TypeList <P1, TypeList <P2,
-    TypeList <P3, TypeList <P4, TypeList <P5, TypeList <P6,
-    TypeList <P7, TypeList <P8> > > > > > > > > &tvl)
+  template <std::size_t... I>
+  static T* call (void* mem, Values& tvl, IndexSequence <I...>)
   {
-    return new (mem) T(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd,
-      tvl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.hd,
-      tvl.tl.tl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.tl.tl.hd);
+    return new (mem) T (tvl.template get <I> ()...);
   }
 };
 
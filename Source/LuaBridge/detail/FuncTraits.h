@@ -48,258 +48,109 @@ namespace luabridge {
 
 //==============================================================================
 /**
-    Traits for function pointers.
-
-    There are three types of functions: global, non-const member, and const
-    member. These templates determine the type of function, which class type it
-    belongs to if it is a class member, the const-ness if it is a member
-    function, and the type information for the return value and argument list.
+    Invoke a function with the contents of a type/value list.
 
-    Expansions are provided for functions with up to 8 parameters. This can be
-    manually extended, or expanded to an arbitrary amount using C++11 features.
+    The values are forwarded to the function, so references to registered
+    classes and strings bind to the values read from the stack without a copy.
 */
-template <class MemFn, class D = MemFn>
-struct FuncTraits
-{
-};
-
-/* Ordinary function pointers. */
+template <class R, class Params>
+struct Invoke;
 
-template <class R, class D>
-struct FuncTraits <R (*) (), D>
+template <class R, class... Params>
+struct Invoke <R, TypeList <Params...> >
 {
-  static bool const isMemberFunction = false;
-  typedef D DeclType;
-  typedef R ReturnType;
-  typedef None Params;
-  static R call (D fp, TypeListValues <Params>)
-  {
-    return fp ();
-  }
-};
+  typedef TypeListValues <TypeList <Params...> > Values;
+  typedef typename MakeIndexSequence <sizeof... (Params)>::Type Indices;
 
-template <class R, class P1, class D>
-struct FuncTraits <R (*) (P1), D>
-{
-  static bool const isMemberFunction = false;
-  typedef D DeclType;
-  typedef R ReturnType;
-  typedef TypeList <P1> Params;
-  static R call (D fp, TypeListValues <Params> tvl)
+  template <class Fn>
+  static R call (Fn const& fn, Values& tvl)
   {
-    return fp (tvl.hd);
+    return call (fn, tvl, Indices ());
   }
-};
 
-template <class R, class P1, class P2, class D>
-struct FuncTraits <R (*) (P1, P2), D>
-{
-  static bool const isMemberFunction = false;
-  typedef D DeclType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2> > Params;
-  static R call (D fp, TypeListValues <Params> tvl)
+  template <class T, class MemFn>
+  static R call (T* obj, MemFn const& fn, Values& tvl)
   {
-    return fp (tvl.hd, tvl.tl.hd);
+    return call (obj, fn, tvl, Indices ());
   }
-};
 
-template <class R, class P1, class P2, class P3, class D>
-struct FuncTraits <R (*) (P1, P2, P3), D>
-{
-  static bool const isMemberFunction = false;
-  typedef D DeclType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3> > > Params;
-  static R call (D fp, TypeListValues <Params> tvl)
-  {
-    return fp (tvl.hd, tvl.tl.hd, tvl.tl.tl.hd);
-  }
-};
+  /** Call a member function with values that are reused by later calls.
 
-template <class R, class P1, class P2, class P3, class P4, class D>
-struct FuncTraits <R (*) (P1, P2, P3, P4), D>
-{
-  static bool const isMemberFunction = false;
-  typedef D DeclType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3, TypeList <P4> > > > Params;
-  static R call (D fp, TypeListValues <Params> tvl)
+      The values are passed as lvalues, or as copies to rvalue reference
+      parameters, so they are never moved from.
+  */
+  template <class T, class MemFn>
+  static R callShared (T* obj, MemFn const& fn, Values& tvl)
   {
-    return fp (tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd);
+    return callShared (obj, fn, tvl, Indices ());
   }
-};
 
-template <class R, class P1, class P2, class P3, class P4, class P5, class D>
-struct FuncTraits <R (*) (P1, P2, P3, P4, P5), D>
-{
-  static bool const isMemberFunction = false;
-  typedef D DeclType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3, TypeList <P4, TypeList <P5> > > > > Params;
-  static R call (D fp, TypeListValues <Params> tvl)
+private:
+  template <class Fn, std::size_t... I>
+  static R call (Fn const& fn, Values& tvl, IndexSequence <I...>)
   {
-    return fp (tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.hd);
+    return fn (tvl.template get <I> ()...);
   }
-};
 
-template <class R, class P1, class P2, class P3, class P4, class P5, class P6, class D>
-struct FuncTraits <R (*) (P1, P2, P3, P4, P5, P6), D>
-{
-  static bool const isMemberFunction = false;
-  typedef D DeclType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3, TypeList <P4, TypeList <P5,  TypeList <P6> > > > > > Params;
-  static R call (D fp, TypeListValues <Params> tvl)
+  template <class T, class MemFn, std::size_t... I>
+  static R call (T* obj, MemFn const& fn, Values& tvl, IndexSequence <I...>)
   {
-    return fp (tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.hd);
+    return (obj->*fn) (tvl.template get <I> ()...);
   }
-};
 
-template <class R, class P1, class P2, class P3, class P4, class P5, class P6, class P7, class D>
-struct FuncTraits <R (*) (P1, P2, P3, P4, P5, P6, P7), D>
-{
-  static bool const isMemberFunction = false;
-  typedef D DeclType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3, TypeList <P4, TypeList <P5, TypeList <P6, TypeList <P7> > > > > > > Params;
-  static R call (D fp, TypeListValues <Params> tvl)
+  template <class T, class MemFn, std::size_t... I>
+  static R callShared (T* obj, MemFn const& fn, Values& tvl, IndexSequence <I...>)
   {
-    return fp (tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.tl.hd);
+    return (obj->*fn) (tvl.template getShared <I> ()...);
   }
 };
 
-template <class R, class P1, class P2, class P3, class P4, class P5, class P6, class P7, class P8, class D>
-struct FuncTraits <R (*) (P1, P2, P3, P4, P5, P6, P7, P8), D>
-{
-  static bool const isMemberFunction = false;
-  typedef D DeclType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3, TypeList <P4, TypeList <P5, TypeList <P6, TypeList <P7, TypeList <P8> > > > > > > > Params;
-  static R call (D fp, TypeListValues <Params> tvl)
-  {
-    return fp (tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.tl.tl.hd);
-  }
-};
-
-/* Windows: WINAPI (a.k.a. __stdcall) function pointers. */
-
-#ifdef _M_IX86 // Windows 32bit only
-
-template <class R, class D>
-struct FuncTraits <R (__stdcall *) (), D>
-{
-  static bool const isMemberFunction = false;
-  typedef D DeclType;
-  typedef R ReturnType;
-  typedef None Params;
-  static R call (D fp, TypeListValues <Params>)
-  {
-    return fp ();
-  }
-};
-
-template <class R, class P1, class D>
-struct FuncTraits <R (__stdcall *) (P1), D>
-{
-  static bool const isMemberFunction = false;
-  typedef D DeclType;
-  typedef R ReturnType;
-  typedef TypeList <P1> Params;
-  static R call (D fp, TypeListValues <Params> tvl)
-  {
-    return fp (tvl.hd);
-  }
-};
+//==============================================================================
+/**
+    Traits for function pointers.
 
-template <class R, class P1, class P2, class D>
-struct FuncTraits <R (__stdcall *) (P1, P2), D>
-{
-  static bool const isMemberFunction = false;
-  typedef D DeclType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2> > Params;
-  static R call (D fp, TypeListValues <Params> tvl)
-  {
-    return fp (tvl.hd, tvl.tl.hd);
-  }
-};
+    There are three types of functions: global, non-const member, and const
+    member. These templates determine the type of function, which class type it
+    belongs to if it is a class member, the const-ness if it is a member
+    function, and the type information for the return value and argument list.
 
-template <class R, class P1, class P2, class P3, class D>
-struct FuncTraits <R (__stdcall *) (P1, P2, P3), D>
+    The parameter lists are expanded with variadic templates, so there is no
+    limit on the number of parameters.
+*/
+template <class MemFn, class D = MemFn>
+struct FuncTraits
 {
-  static bool const isMemberFunction = false;
-  typedef D DeclType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3> > > Params;
-  static R call (D fp, TypeListValues <Params> tvl)
-  {
-    return fp (tvl.hd, tvl.tl.hd, tvl.tl.tl.hd);
-  }
 };
 
-template <class R, class P1, class P2, class P3, class P4, class D>
-struct FuncTraits <R (__stdcall *) (P1, P2, P3, P4), D>
-{
-  static bool const isMemberFunction = false;
-  typedef D DeclType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3, TypeList <P4> > > > Params;
-  static R call (D fp, TypeListValues <Params> tvl)
-  {
-    return fp (tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd);
-  }
-};
+/* Ordinary function pointers. */
 
-template <class R, class P1, class P2, class P3, class P4, class P5, class D>
-struct FuncTraits <R (__stdcall *) (P1, P2, P3, P4, P5), D>
+template <class R, class... P, class D>
+struct FuncTraits <R (*) (P...), D>
 {
   static bool const isMemberFunction = false;
   typedef D DeclType;
   typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3, TypeList <P4, TypeList <P5> > > > > Params;
-  static R call (D fp, TypeListValues <Params> tvl)
+  typedef TypeList <P...> Params;
+  static R call (D fp, TypeListValues <Params>& tvl)
   {
-    return fp (tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.hd);
+    return Invoke <R, Params>::call (fp, tvl);
   }
 };
 
-template <class R, class P1, class P2, class P3, class P4, class P5, class P6, class D>
-struct FuncTraits <R (__stdcall *) (P1, P2, P3, P4, P5, P6), D>
-{
-  static bool const isMemberFunction = false;
-  typedef D DeclType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3, TypeList <P4, TypeList <P5, TypeList <P6> > > > > > Params;
-  static R call (D fp, TypeListValues <Params> tvl)
-  {
-    return fp (tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.hd);
-  }
-};
+/* Windows: WINAPI (a.k.a. __stdcall) function pointers. */
 
-template <class R, class P1, class P2, class P3, class P4, class P5, class P6, class P7, class D>
-struct FuncTraits <R (__stdcall *) (P1, P2, P3, P4, P5, P6, P7), D>
-{
-  static bool const isMemberFunction = false;
-  typedef D DeclType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3, TypeList <P4, TypeList <P5, TypeList <P6, TypeList <P7> > > > > > > Params;
-  static R call (D fp, TypeListValues <Params> tvl)
-  {
-    return fp (tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.tl.hd);
-  }
-};
+#ifdef _M_IX86 // Windows 32bit only
 
-template <class R, class P1, class P2, class P3, class P4, class P5, class P6, class P7, class P8, class D>
-struct FuncTraits <R (__stdcall *) (P1, P2, P3, P4, P5, P6, P7, P8), D>
+template <class R, class... P, class D>
+struct FuncTraits <R (__stdcall *) (P...), D>
 {
   static bool const isMemberFunction = false;
   typedef D DeclType;
   typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3, TypeList <P4, TypeList <P5, TypeList <P6, TypeList <P7, TypeList <P8> > > > > > > > Params;
-  static R call (D fp, TypeListValues <Params> tvl)
+  typedef TypeList <P...> Params;
+  static R call (D fp, TypeListValues <Params>& tvl)
   {
-    return fp (tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.tl.tl.hd);
+    return Invoke <R, Params>::call (fp, tvl);
   }
 };
 
@@ -307,672 +158,142 @@ struct FuncTraits <R (__stdcall *) (P1, P2, P3, P4, P5, P6, P7, P8), D>
 
 /* Non-const member function pointers. */
 
-template <class T, class R, class D>
-struct FuncTraits <R (T::*) (), D>
-{
-  static bool const isMemberFunction = true;
-  static bool const isConstMemberFunction = false;
-  typedef D DeclType;
-  typedef T ClassType;
-  typedef R ReturnType;
-  typedef None Params;
-  static R call (T* obj, D fp, TypeListValues <Params>)
-  {
-    return (obj->*fp)();
-  }
-};
-
-template <class T, class R, class P1, class D>
-struct FuncTraits <R (T::*) (P1), D>
+template <class T, class R, class... P, class D>
+struct FuncTraits <R (T::*) (P...), D>
 {
   static bool const isMemberFunction = true;
   static bool const isConstMemberFunction = false;
   typedef D DeclType;
   typedef T ClassType;
   typedef R ReturnType;
-  typedef TypeList <P1> Params;
-  static R call (T* obj, D fp, TypeListValues <Params> tvl)
+  typedef TypeList <P...> Params;
+  static R call (T* obj, D fp, TypeListValues <Params>& tvl)
   {
-    return (obj->*fp)(tvl.hd);
-  }
-};
-
-template <class T, class R, class P1, class P2, class D>
-struct FuncTraits <R (T::*) (P1, P2), D>
-{
-  static bool const isMemberFunction = true;
-  static bool const isConstMemberFunction = false;
-  typedef D DeclType;
-  typedef T ClassType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2> > Params;
-  static R call (T* obj, D fp, TypeListValues <Params> tvl)
-  {
-    return (obj->*fp)(tvl.hd, tvl.tl.hd);
-  }
-};
-
-template <class T, class R, class P1, class P2, class P3, class D>
-struct FuncTraits <R (T::*) (P1, P2, P3), D>
-{
-  static bool const isMemberFunction = true;
-  static bool const isConstMemberFunction = false;
-  typedef D DeclType;
-  typedef T ClassType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3> > > Params;
-  static R call (T* obj, D fp, TypeListValues <Params> tvl)
-  {
-    return (obj->*fp)(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd);
-  }
-};
-
-template <class T, class R, class P1, class P2, class P3, class P4, class D>
-struct FuncTraits <R (T::*) (P1, P2, P3, P4), D>
-{
-  static bool const isMemberFunction = true;
-  static bool const isConstMemberFunction = false;
-  typedef D DeclType;
-  typedef T ClassType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3, TypeList <P4> > > > Params;
-  static R call (T* obj, D fp, TypeListValues <Params> tvl)
-  {
-    return (obj->*fp)(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd);
-  }
-};
-
-template <class T, class R, class P1, class P2, class P3, class P4, class P5, class D>
-struct FuncTraits <R (T::*) (P1, P2, P3, P4, P5), D>
-{
-  static bool const isMemberFunction = true;
-  static bool const isConstMemberFunction = false;
-  typedef D DeclType;
-  typedef T ClassType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3, TypeList <P4, TypeList <P5> > > > > Params;
-  static R call (T* obj, D fp, TypeListValues <Params> tvl)
-  {
-    return (obj->*fp)(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.hd);
-  }
-};
-
-template <class T, class R, class P1, class P2, class P3, class P4, class P5, class P6, class D>
-struct FuncTraits <R (T::*) (P1, P2, P3, P4, P5, P6), D>
-{
-  static bool const isMemberFunction = true;
-  static bool const isConstMemberFunction = false;
-  typedef D DeclType;
-  typedef T ClassType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3, TypeList <P4, TypeList <P5, TypeList <P6> > > > > > Params;
-  static R call (T* obj, D fp, TypeListValues <Params> tvl)
-  {
-    return (obj->*fp)(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.hd);
-  }
-};
-
-template <class T, class R, class P1, class P2, class P3, class P4, class P5, class P6, class P7, class D>
-struct FuncTraits <R (T::*) (P1, P2, P3, P4, P5, P6, P7), D>
-{
-  static bool const isMemberFunction = true;
-  static bool const isConstMemberFunction = false;
-  typedef D DeclType;
-  typedef T ClassType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3, TypeList <P4, TypeList <P5, TypeList <P6, TypeList <P7> > > > > > > Params;
-  static R call (T* obj, D fp, TypeListValues <Params> tvl)
-  {
-    return (obj->*fp)(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.tl.hd);
-  }
-};
-
-template <class T, class R, class P1, class P2, class P3, class P4, class P5, class P6, class P7, class P8, class D>
-struct FuncTraits <R (T::*) (P1, P2, P3, P4, P5, P6, P7, P8), D>
-{
-  static bool const isMemberFunction = true;
-  static bool const isConstMemberFunction = false;
-  typedef D DeclType;
-  typedef T ClassType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3, TypeList <P4, TypeList <P5, TypeList <P6, TypeList <P7, TypeList <P8> > > > > > > > Params;
-  static R call (T* obj, D fp, TypeListValues <Params> tvl)
-  {
-    return (obj->*fp)(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.tl.tl.hd);
+    return Invoke <R, Params>::call (obj, fp, tvl);
   }
 };
 
 /* Const member function pointers. */
 
-template <class T, class R, class D>
-struct FuncTraits <R (T::*) () const, D>
+template <class T, class R, class... P, class D>
+struct FuncTraits <R (T::*) (P...) const, D>
 {
   static bool const isMemberFunction = true;
   static bool const isConstMemberFunction = true;
   typedef D DeclType;
   typedef T ClassType;
   typedef R ReturnType;
-  typedef None Params;
-  static R call (T const* obj, D fp, TypeListValues <Params>)
+  typedef TypeList <P...> Params;
+  static R call (T const* obj, D fp, TypeListValues <Params>& tvl)
   {
-    return (obj->*fp)();
+    return Invoke <R, Params>::call (obj, fp, tvl);
   }
 };
 
-template <class T, class R, class P1, class D>
-struct FuncTraits <R (T::*) (P1) const, D>
-{
-  static bool const isMemberFunction = true;
-  static bool const isConstMemberFunction = true;
-  typedef D DeclType;
-  typedef T ClassType;
-  typedef R ReturnType;
-  typedef TypeList <P1> Params;
-  static R call (T const* obj, D fp, TypeListValues <Params> tvl)
-  {
-    return (obj->*fp)(tvl.hd);
-  }
-};
+#if defined (__cpp_noexcept_function_type)
 
-template <class T, class R, class P1, class P2, class D>
-struct FuncTraits <R (T::*) (P1, P2) const, D>
-{
-  static bool const isMemberFunction = true;
-  static bool const isConstMemberFunction = true;
-  typedef D DeclType;
-  typedef T ClassType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2> > Params;
-  static R call (T const* obj, R (T::*fp) (P1, P2) const,
-    TypeListValues <Params> tvl)
-  {
-    return (obj->*fp)(tvl.hd, tvl.tl.hd);
-  }
-};
+/* Since C++17 the noexcept specification is a part of the function type,
+   so noexcept function pointers need their own specializations. */
 
-template <class T, class R, class P1, class P2, class P3, class D>
-struct FuncTraits <R (T::*) (P1, P2, P3) const, D>
-{
-  static bool const isMemberFunction = true;
-  static bool const isConstMemberFunction = true;
-  typedef D DeclType;
-  typedef T ClassType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3> > > Params;
-  static R call (T const* obj, D fp, TypeListValues <Params> tvl)
-  {
-    return (obj->*fp)(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd);
-  }
-};
+/* Ordinary noexcept function pointers. */
 
-template <class T, class R, class P1, class P2, class P3, class P4, class D>
-struct FuncTraits <R (T::*) (P1, P2, P3, P4) const, D>
+template <class R, class... P, class D>
+struct FuncTraits <R (*) (P...) noexcept, D>
 {
-  static bool const isMemberFunction = true;
-  static bool const isConstMemberFunction = true;
+  static bool const isMemberFunction = false;
   typedef D DeclType;
-  typedef T ClassType;
   typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3, TypeList <P4> > > > Params;
-  static R call (T const* obj, D fp, TypeListValues <Params> tvl)
+  typedef TypeList <P...> Params;
+  static R call (D fp, TypeListValues <Params>& tvl)
   {
-    return (obj->*fp)(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd);
+    return Invoke <R, Params>::call (fp, tvl);
   }
 };
 
-template <class T, class R, class P1, class P2, class P3, class P4, class P5, class D>
-struct FuncTraits <R (T::*) (P1, P2, P3, P4, P5) const, D>
-{
-  static bool const isMemberFunction = true;
-  static bool const isConstMemberFunction = true;
-  typedef D DeclType;
-  typedef T ClassType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3, TypeList <P4, TypeList <P5> > > > > Params;
-  static R call (T const* obj, D fp, TypeListValues <Params> tvl)
-  {
-    return (obj->*fp)(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.hd);
-  }
-};
+/* Non-const noexcept member function pointers. */
 
-template <class T, class R, class P1, class P2, class P3, class P4, class P5, class P6, class D>
-struct FuncTraits <R (T::*) (P1, P2, P3, P4, P5, P6) const, D>
+template <class T, class R, class... P, class D>
+struct FuncTraits <R (T::*) (P...) noexcept, D>
 {
   static bool const isMemberFunction = true;
-  static bool const isConstMemberFunction = true;
+  static bool const isConstMemberFunction = false;
   typedef D DeclType;
   typedef T ClassType;
   typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3, TypeList <P4, TypeList <P5, TypeList <P6> > > > > > Params;
-  static R call (T const* obj, D fp, TypeListValues <Params> tvl)
+  typedef TypeList <P...> Params;
+  static R call (T* obj, D fp, TypeListValues <Params>& tvl)
   {
-    return (obj->*fp)(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.hd);
+    return Invoke <R, Params>::call (obj, fp, tvl);
   }
 };
 
-template <class T, class R, class P1, class P2, class P3, class P4, class P5, class P6, class P7, class D>
-struct FuncTraits <R (T::*) (P1, P2, P3, P4, P5, P6, P7) const, D>
-{
-  static bool const isMemberFunction = true;
-  static bool const isConstMemberFunction = true;
-  typedef D DeclType;
-  typedef T ClassType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3, TypeList <P4, TypeList <P5, TypeList <P6, TypeList <P7> > > > > > > Params;
-  static R call (T const* obj, D fp, TypeListValues <Params> tvl)
-  {
-    return (obj->*fp)(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.tl.hd);
-  }
-};
+/* Const noexcept member function pointers. */
 
-template <class T, class R, class P1, class P2, class P3, class P4, class P5, class P6, class P7, class P8, class D>
-struct FuncTraits <R (T::*) (P1, P2, P3, P4, P5, P6, P7, P8) const, D>
+template <class T, class R, class... P, class D>
+struct FuncTraits <R (T::*) (P...) const noexcept, D>
 {
   static bool const isMemberFunction = true;
   static bool const isConstMemberFunction = true;
   typedef D DeclType;
   typedef T ClassType;
   typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3, TypeList <P4, TypeList <P5, TypeList <P6, TypeList <P7, TypeList <P8> > > > > > > > Params;
-  static R call (T const* obj, D fp, TypeListValues <Params> tvl)
+  typedef TypeList <P...> Params;
+  static R call (T const* obj, D fp, TypeListValues <Params>& tvl)
   {
-    return (obj->*fp)(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.tl.tl.hd);
+    return Invoke <R, Params>::call (obj, fp, tvl);
   }
 };
 
-#if defined (LUABRIDGE_THROWSPEC)
-
-/* Ordinary function pointers. */
+#endif // __cpp_noexcept_function_type
 
-template <class R, class D>
-struct FuncTraits <R (*) () LUABRIDGE_THROWSPEC, D>
-{
-  static bool const isMemberFunction = false;
-  typedef D DeclType;
-  typedef R ReturnType;
-  typedef None Params;
-  static R call (D fp, TypeListValues <Params> const&)
-  {
-    return fp ();
-  }
-};
-
-template <class R, class P1, class D>
-struct FuncTraits <R (*) (P1) LUABRIDGE_THROWSPEC, D>
-{
-  static bool const isMemberFunction = false;
-  typedef D DeclType;
-  typedef R ReturnType;
-  typedef TypeList <P1> Params;
-  static R call (D fp, TypeListValues <Params> tvl)
-  {
-    return fp (tvl.hd);
-  }
-};
-
-template <class R, class P1, class P2, class D>
-struct FuncTraits <R (*) (P1, P2) LUABRIDGE_THROWSPEC, D>
-{
-  static bool const isMemberFunction = false;
-  typedef D DeclType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2> > Params;
-  static R call (D fp, TypeListValues <Params> tvl)
-  {
-    return fp (tvl.hd, tvl.tl.hd);
-  }
-};
-
-template <class R, class P1, class P2, class P3, class D>
-struct FuncTraits <R (*) (P1, P2, P3) LUABRIDGE_THROWSPEC, D>
-{
-  static bool const isMemberFunction = false;
-  typedef D DeclType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3> > > Params;
-  static R call (D fp, TypeListValues <Params> tvl)
-  {
-    return fp (tvl.hd, tvl.tl.hd, tvl.tl.tl.hd);
-  }
-};
-
-template <class R, class P1, class P2, class P3, class P4, class D>
-struct FuncTraits <R (*) (P1, P2, P3, P4) LUABRIDGE_THROWSPEC, D>
-{
-  static bool const isMemberFunction = false;
-  typedef D DeclType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3, TypeList <P4> > > > Params;
-  static R call (D fp, TypeListValues <Params> tvl)
-  {
-    return fp (tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd);
-  }
-};
-
-template <class R, class P1, class P2, class P3, class P4, class P5, class D>
-struct FuncTraits <R (*) (P1, P2, P3, P4, P5) LUABRIDGE_THROWSPEC, D>
-{
-  static bool const isMemberFunction = false;
-  typedef D DeclType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3, TypeList <P4, TypeList <P5> > > > > Params;
-  static R call (D fp, TypeListValues <Params> tvl)
-  {
-    return fp (tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.hd);
-  }
-};
-
-template <class R, class P1, class P2, class P3, class P4, class P5, class P6, class D>
-struct FuncTraits <R (*) (P1, P2, P3, P4, P5, P6) LUABRIDGE_THROWSPEC, D>
-{
-  static bool const isMemberFunction = false;
-  typedef D DeclType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3, TypeList <P4, TypeList <P5,  TypeList <P6> > > > > > Params;
-  static R call (D fp, TypeListValues <Params> tvl)
-  {
-    return fp (tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.hd);
-  }
-};
+#if defined (LUABRIDGE_THROWSPEC)
 
-template <class R, class P1, class P2, class P3, class P4, class P5, class P6, class P7, class D>
-struct FuncTraits <R (*) (P1, P2, P3, P4, P5, P6, P7) LUABRIDGE_THROWSPEC, D>
-{
-  static bool const isMemberFunction = false;
-  typedef D DeclType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3, TypeList <P4, TypeList <P5, TypeList <P6, TypeList <P7> > > > > > > Params;
-  static R call (D fp, TypeListValues <Params> tvl)
-  {
-    return fp (tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.tl.hd);
-  }
-};
+/* Ordinary function pointers with THROWSPEC. */
 
-template <class R, class P1, class P2, class P3, class P4, class P5, class P6, class P7, class P8, class D>
-struct FuncTraits <R (*) (P1, P2, P3, P4, P5, P6, P7, P8) LUABRIDGE_THROWSPEC, D>
+template <class R, class... P, class D>
+struct FuncTraits <R (*) (P...) LUABRIDGE_THROWSPEC, D>
 {
   static bool const isMemberFunction = false;
   typedef D DeclType;
   typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3, TypeList <P4, TypeList <P5, TypeList <P6, TypeList <P7, TypeList <P8> > > > > > > > Params;
-  static R call (D fp, TypeListValues <Params> tvl)
+  typedef TypeList <P...> Params;
+  static R call (D fp, TypeListValues <Params>& tvl)
   {
-    return fp (tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.tl.tl.hd);
+    return Invoke <R, Params>::call (fp, tvl);
   }
 };
 
 /* Non-const member function pointers with THROWSPEC. */
 
-template <class T, class R, class D>
-struct FuncTraits <R (T::*) () LUABRIDGE_THROWSPEC, D>
-{
-  static bool const isMemberFunction = true;
-  static bool const isConstMemberFunction = false;
-  typedef D DeclType;
-  typedef T ClassType;
-  typedef R ReturnType;
-  typedef None Params;
-  static R call (T* obj, D fp, TypeListValues <Params> const&)
-  {
-    return (obj->*fp)();
-  }
-};
-
-template <class T, class R, class P1, class D>
-struct FuncTraits <R (T::*) (P1) LUABRIDGE_THROWSPEC, D>
-{
-  static bool const isMemberFunction = true;
-  static bool const isConstMemberFunction = false;
-  typedef D DeclType;
-  typedef T ClassType;
-  typedef R ReturnType;
-  typedef TypeList <P1> Params;
-  static R call (T* obj, D fp, TypeListValues <Params> tvl)
-  {
-    return (obj->*fp)(tvl.hd);
-  }
-};
-
-template <class T, class R, class P1, class P2, class D>
-struct FuncTraits <R (T::*) (P1, P2) LUABRIDGE_THROWSPEC, D>
-{
-  static bool const isMemberFunction = true;
-  static bool const isConstMemberFunction = false;
-  typedef D DeclType;
-  typedef T ClassType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2> > Params;
-  static R call (T* obj, D fp, TypeListValues <Params> tvl)
-  {
-    return (obj->*fp)(tvl.hd, tvl.tl.hd);
-  }
-};
-
-template <class T, class R, class P1, class P2, class P3, class D>
-struct FuncTraits <R (T::*) (P1, P2, P3) LUABRIDGE_THROWSPEC, D>
-{
-  static bool const isMemberFunction = true;
-  static bool const isConstMemberFunction = false;
-  typedef D DeclType;
-  typedef T ClassType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3> > > Params;
-  static R call (T* obj, D fp, TypeListValues <Params> tvl)
-  {
-    return (obj->*fp)(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd);
-  }
-};
-
-template <class T, class R, class P1, class P2, class P3, class P4, class D>
-struct FuncTraits <R (T::*) (P1, P2, P3, P4) LUABRIDGE_THROWSPEC, D>
-{
-  static bool const isMemberFunction = true;
-  static bool const isConstMemberFunction = false;
-  typedef D DeclType;
-  typedef T ClassType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3, TypeList <P4> > > > Params;
-  static R call (T* obj, D fp, TypeListValues <Params> tvl)
-  {
-    return (obj->*fp)(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd);
-  }
-};
-
-template <class T, class R, class P1, class P2, class P3, class P4, class P5, class D>
-struct FuncTraits <R (T::*) (P1, P2, P3, P4, P5) LUABRIDGE_THROWSPEC, D>
-{
-  static bool const isMemberFunction = true;
-  static bool const isConstMemberFunction = false;
-  typedef D DeclType;
-  typedef T ClassType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3, TypeList <P4, TypeList <P5> > > > > Params;
-  static R call (T* obj, D fp, TypeListValues <Params> tvl)
-  {
-    return (obj->*fp)(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.hd);
-  }
-};
-
-template <class T, class R, class P1, class P2, class P3, class P4, class P5, class P6, class D>
-struct FuncTraits <R (T::*) (P1, P2, P3, P4, P5, P6) LUABRIDGE_THROWSPEC, D>
-{
-  static bool const isMemberFunction = true;
-  static bool const isConstMemberFunction = false;
-  typedef D DeclType;
-  typedef T ClassType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3, TypeList <P4, TypeList <P5, TypeList <P6> > > > > > Params;
-  static R call (T* obj, D fp, TypeListValues <Params> tvl)
-  {
-    return (obj->*fp)(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.hd);
-  }
-};
-
-template <class T, class R, class P1, class P2, class P3, class P4, class P5, class P6, class P7, class D>
-struct FuncTraits <R (T::*) (P1, P2, P3, P4, P5, P6, P7) LUABRIDGE_THROWSPEC, D>
+template <class T, class R, class... P, class D>
+struct FuncTraits <R (T::*) (P...) LUABRIDGE_THROWSPEC, D>
 {
   static bool const isMemberFunction = true;
   static bool const isConstMemberFunction = false;
   typedef D DeclType;
   typedef T ClassType;
   typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3, TypeList <P4, TypeList <P5, TypeList <P6, TypeList <P7> > > > > > > Params;
-  static R call (T* obj, D fp, TypeListValues <Params> tvl)
+  typedef TypeList <P...> Params;
+  static R call (T* obj, D fp, TypeListValues <Params>& tvl)
   {
-    return (obj->*fp)(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.tl.hd);
-  }
-};
-
-template <class T, class R, class P1, class P2, class P3, class P4, class P5, class P6, class P7, class P8, class D>
-struct FuncTraits <R (T::*) (P1, P2, P3, P4, P5, P6, P7, P8) LUABRIDGE_THROWSPEC, D>
-{
-  static bool const isMemberFunction = true;
-  static bool const isConstMemberFunction = false;
-  typedef D DeclType;
-  typedef T ClassType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3, TypeList <P4, TypeList <P5, TypeList <P6, TypeList <P7, TypeList <P8> > > > > > > > Params;
-  static R call (T* obj, D fp, TypeListValues <Params> tvl)
-  {
-    return (obj->*fp)(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.tl.tl.hd);
+    return Invoke <R, Params>::call (obj, fp, tvl);
   }
 };
 
 /* Const member function pointers with THROWSPEC. */
 
-template <class T, class R, class D>
-struct FuncTraits <R (T::*) () const LUABRIDGE_THROWSPEC, D>
-{
-  static bool const isMemberFunction = true;
-  static bool const isConstMemberFunction = true;
-  typedef D DeclType;
-  typedef T ClassType;
-  typedef R ReturnType;
-  typedef None Params;
-  static R call (T const* obj, D fp, TypeListValues <Params>)
-  {
-    return (obj->*fp)();
-  }
-};
-
-template <class T, class R, class P1, class D>
-struct FuncTraits <R (T::*) (P1) const LUABRIDGE_THROWSPEC, D>
-{
-  static bool const isMemberFunction = true;
-  static bool const isConstMemberFunction = true;
-  typedef D DeclType;
-  typedef T ClassType;
-  typedef R ReturnType;
-  typedef TypeList <P1> Params;
-  static R call (T const* obj, D fp, TypeListValues <Params> tvl)
-  {
-    return (obj->*fp)(tvl.hd);
-  }
-};
-
-template <class T, class R, class P1, class P2, class D>
-struct FuncTraits <R (T::*) (P1, P2) const LUABRIDGE_THROWSPEC, D>
-{
-  static bool const isMemberFunction = true;
-  static bool const isConstMemberFunction = true;
-  typedef D DeclType;
-  typedef T ClassType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2> > Params;
-  static R call (T const* obj, D fp, TypeListValues <Params> tvl)
-  {
-    return (obj->*fp)(tvl.hd, tvl.tl.hd);
-  }
-};
-
-template <class T, class R, class P1, class P2, class P3, class D>
-struct FuncTraits <R (T::*) (P1, P2, P3) const LUABRIDGE_THROWSPEC, D>
-{
-  static bool const isMemberFunction = true;
-  static bool const isConstMemberFunction = true;
-  typedef D DeclType;
-  typedef T ClassType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3> > > Params;
-  static R call (T const* obj, D fp, TypeListValues <Params> tvl)
-  {
-    return (obj->*fp)(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd);
-  }
-};
-
-template <class T, class R, class P1, class P2, class P3, class P4, class D>
-struct FuncTraits <R (T::*) (P1, P2, P3, P4) const LUABRIDGE_THROWSPEC, D>
-{
-  static bool const isMemberFunction = true;
-  static bool const isConstMemberFunction = true;
-  typedef D DeclType;
-  typedef T ClassType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3, TypeList <P4> > > > Params;
-  static R call (T const* obj, D fp, TypeListValues <Params> tvl)
-  {
-    return (obj->*fp)(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd);
-  }
-};
-
-template <class T, class R, class P1, class P2, class P3, class P4, class P5, class D>
-struct FuncTraits <R (T::*) (P1, P2, P3, P4, P5) const LUABRIDGE_THROWSPEC, D>
-{
-  static bool const isMemberFunction = true;
-  static bool const isConstMemberFunction = true;
-  typedef D DeclType;
-  typedef T ClassType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3, TypeList <P4, TypeList <P5> > > > > Params;
-  static R call (T const* obj, D fp, TypeListValues <Params> tvl)
-  {
-    return (obj->*fp)(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd,
-      tvl.tl.tl.tl.tl.hd);
-  }
-};
-
-template <class T, class R, class P1, class P2, class P3, class P4, class P5, class P6, class D>
-struct FuncTraits <R (T::*) (P1, P2, P3, P4, P5, P6) const LUABRIDGE_THROWSPEC, D>
-{
-  static bool const isMemberFunction = true;
-  static bool const isConstMemberFunction = true;
-  typedef D DeclType;
-  typedef T ClassType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3, TypeList <P4, TypeList <P5, TypeList <P6> > > > > > Params;
-  static R call (T const* obj, D fp, TypeListValues <Params> tvl)
-  {
-    return (obj->*fp)(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.hd);
-  }
-};
-
-template <class T, class R, class P1, class P2, class P3, class P4, class P5, class P6, class P7, class D>
-struct FuncTraits <R (T::*) (P1, P2, P3, P4, P5, P6, P7) const LUABRIDGE_THROWSPEC, D>
-{
-  static bool const isMemberFunction = true;
-  static bool const isConstMemberFunction = true;
-  typedef D DeclType;
-  typedef T ClassType;
-  typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3, TypeList <P4, TypeList <P5, TypeList <P6, TypeList <P7> > > > > > > Params;
-  static R call (T const* obj, D fp, TypeListValues <Params> tvl)
-  {
-    return (obj->*fp)(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.tl.hd);
-  }
-};
-
-template <class T, class R, class P1, class P2, class P3, class P4, class P5, class P6, class P7, class P8, class D>
-struct FuncTraits <R (T::*) (P1, P2, P3, P4, P5, P6, P7, P8) const LUABRIDGE_THROWSPEC, D>
+template <class T, class R, class... P, class D>
+struct FuncTraits <R (T::*) (P...) const LUABRIDGE_THROWSPEC, D>
 {
   static bool const isMemberFunction = true;
   static bool const isConstMemberFunction = true;
   typedef D DeclType;
   typedef T ClassType;
   typedef R ReturnType;
-  typedef TypeList <P1, TypeList <P2, TypeList <P3, TypeList <P4, TypeList <P5, TypeList <P6, TypeList <P7, TypeList <P8> > > > > > > > Params;
-  static R call (T const* obj, D fp, TypeListValues <Params> tvl)
+  typedef TypeList <P...> Params;
+  static R call (T const* obj, D fp, TypeListValues <Params>& tvl)
   {
-    return (obj->*fp)(tvl.hd, tvl.tl.hd, tvl.tl.tl.hd, tvl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.tl.hd, tvl.tl.tl.tl.tl.tl.tl.tl.hd);
+    return Invoke <R, Params>::call (obj, fp, tvl);
   }
 };
 
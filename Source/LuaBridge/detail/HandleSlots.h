@@ -0,0 +1,147 @@
+// https://github.com/vinniefalco/LuaBridge
+//
+// Copyright 2019, Dmitry Tarakanov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace luabridge {
+
+//==============================================================================
+/**
+  A slot map of the objects of a class reachable through handles.
+
+  Each live object occupies a slot. Releasing a slot bumps its generation,
+  so that handles made before are recognized as stale in constant time.
+  Released slots are linked into a free list and reused. Releasing never
+  allocates memory, so that it is safe in destructors.
+
+  This is not thread safe.
+*/
+class HandleSlots
+{
+public:
+  HandleSlots ()
+    : m_firstFree (noSlot)
+  {
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+    Give a slot to an object and return its index.
+  */
+  std::uint32_t acquire (void* object)
+  {
+    std::uint32_t index = m_firstFree;
+    if (index == noSlot)
+    {
+      index = static_cast <std::uint32_t> (m_slots.size ());
+      m_slots.push_back (Slot ());
+    }
+    else
+    {
+      m_firstFree = m_slots [index].nextFree;
+    }
+
+    m_slots [index].object = object;
+    return index;
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+    Release the slot of a destroyed object. Handles to it become stale.
+  */
+  void release (std::uint32_t index)
+  {
+    Slot& slot = m_slots [index];
+    slot.object = 0;
+    ++slot.generation;
+    slot.nextFree = m_firstFree;
+    m_firstFree = index;
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+    Get the current generation of a slot.
+  */
+  std::uint32_t getGeneration (std::uint32_t index) const
+  {
+    return m_slots [index].generation;
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+    Get the object of a slot, or 0 if it was released since the generation.
+  */
+  void* get (std::uint32_t index, std::uint32_t generation) const
+  {
+    if (index < m_slots.size () && m_slots [index].generation == generation)
+      return m_slots [index].object;
+    return 0;
+  }
+
+private:
+  HandleSlots (HandleSlots const&);
+  HandleSlots& operator= (HandleSlots const&);
+
+  static std::uint32_t const noSlot = 0xffffffff;
+
+  struct Slot
+  {
+    Slot ()
+      : object (0)
+      , generation (0)
+      , nextFree (noSlot)
+    {
+    }
+
+    void* object;
+    std::uint32_t generation;
+    std::uint32_t nextFree;
+  };
+
+  std::vector <Slot> m_slots;
+  std::uint32_t m_firstFree;
+};
+
+//==============================================================================
+/**
+  The untyped part of a handle: a slot and the generation it refers to.
+*/
+class HandleBase
+{
+public:
+  //----------------------------------------------------------------------------
+  /**
+    Get the object, or 0 if the handle is empty or the object was destroyed.
+  */
+  void* getObject () const
+  {
+    return m_slots != 0 ? m_slots->get (m_index, m_generation) : 0;
+  }
+
+protected:
+  HandleBase ()
+    : m_slots (0)
+    , m_index (0)
+    , m_generation (0)
+  {
+  }
+
+  HandleBase (HandleSlots const& slots, std::uint32_t index)
+    : m_slots (&slots)
+    , m_index (index)
+    , m_generation (slots.getGeneration (index))
+  {
+  }
+
+private:
+  HandleSlots const* m_slots;
+  std::uint32_t m_index;
+  std::uint32_t m_generation;
+};
+
+} // namespace luabridge
@@ -30,6 +30,8 @@
 #pragma once
 
 #include <cassert>
+#include <climits>
+#include <cstddef>
 
 namespace luabridge {
 
@@ -107,6 +109,13 @@ inline int get_length (lua_State* L, int idx)
 # define LUABRIDGE_LUA_OK LUA_OK
 #endif
 
+/** Defined when the compiler supports C++17, which allows functions to be
+    bound as `auto` non-type template parameters.
+*/
+#if __cplusplus >= 201703L || (defined (_MSVC_LANG) && _MSVC_LANG >= 201703L)
+# define LUABRIDGE_CXX17 1
+#endif
+
 /** Get a table value, bypassing metamethods.
 */  
 inline void rawgetfield (lua_State* L, int index, char const* key)
@@ -135,6 +144,31 @@ inline bool isfulluserdata (lua_State* L, int index)
   return lua_isuserdata (L, index) && !lua_islightuserdata (L, index);
 }
 
+/** Make the garbage collector account for memory allocated outside Lua.
+
+    The bytes are added to the debt of the collector, rounded to kilobytes,
+    and a proportional amount of collection work is done. Lua cannot be told
+    about memory released outside Lua; the debt is paid by that work.
+
+    Nothing is done while the collector is stopped. Lua 5.1 cannot tell
+    whether it is, and a step there restarts a stopped collector.
+*/
+inline void reportExternalMemory (lua_State* L, std::size_t bytes)
+{
+  std::size_t const kilobytes = (bytes + 512) / 1024;
+  if (kilobytes == 0)
+  {
+    return;
+  }
+#if LUA_VERSION_NUM >= 502
+  if (lua_gc (L, LUA_GCISRUNNING, 0) == 0)
+  {
+    return;
+  }
+#endif
+  lua_gc (L, LUA_GCSTEP, kilobytes < INT_MAX ? int (kilobytes) : INT_MAX);
+}
+
 /** Test lua_State objects for global equality.
 
     This can determine if two different lua_State objects really point
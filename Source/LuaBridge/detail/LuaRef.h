@@ -32,9 +32,13 @@
 
 #include <LuaBridge/detail/LuaException.h>
 #include <LuaBridge/detail/Stack.h>
+#include <LuaBridge/detail/TypeList.h>
 
 #include <iostream>
 #include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <map>
 
@@ -69,6 +73,34 @@ struct Stack <Nil>
   }
 };
 
+/**
+  The results of a call to Lua returning several values.
+
+  The values are converted with their Stack specializations before they are
+  popped, so they must not point into Lua memory.
+*/
+template <class... Results>
+struct CallResults
+{
+  static int const count = int (sizeof... (Results));
+
+  /** Convert the values above the stack index top and restore the top.
+  */
+  static std::tuple <Results...> get (lua_State* L, int top)
+  {
+    return get (L, top, typename MakeIndexSequence <sizeof... (Results)>::Type ());
+  }
+
+private:
+  template <std::size_t... Indices>
+  static std::tuple <Results...> get (lua_State* L, int top, IndexSequence <Indices...>)
+  {
+    std::tuple <Results...> results (Stack <Results>::get (L, top + 1 + int (Indices))...);
+    lua_settop (L, top);
+    return results;
+  }
+};
+
 /**
  * Base class for LuaRef and table value proxy classes.
  */
@@ -441,118 +473,43 @@ public:
   /**
       Call Lua code.
 
-      These overloads allow Lua code to be called with up to 8 parameters.
+      The arguments are pushed with their Stack specializations, in order.
       The return value is provided as a LuaRef (which may be LUA_REFNIL).
       If an error occurs, a LuaException is thrown.
   */
-  /** @{ */
-  LuaRef operator() () const
-  {
-    impl ().push ();;
-    LuaException::pcall (m_L, 0, 1);
-    return LuaRef::fromStack (m_L);
-  }
-
-  template <class P1>
-  LuaRef operator() (P1 p1) const
-  {
-    impl ().push ();;
-    Stack <P1>::push (m_L, p1);
-    LuaException::pcall (m_L, 1, 1);
-    return LuaRef::fromStack (m_L);
-  }
-
-  template <class P1, class P2>
-  LuaRef operator() (P1 p1, P2 p2) const
-  {
-    impl ().push ();;
-    Stack <P1>::push (m_L, p1);
-    Stack <P2>::push (m_L, p2);
-    LuaException::pcall (m_L, 2, 1);
-    return LuaRef::fromStack (m_L);
-  }
-
-  template <class P1, class P2, class P3>
-  LuaRef operator() (P1 p1, P2 p2, P3 p3) const
-  {
-    impl ().push ();;
-    Stack <P1>::push (m_L, p1);
-    Stack <P2>::push (m_L, p2);
-    Stack <P3>::push (m_L, p3);
-    LuaException::pcall (m_L, 3, 1);
-    return LuaRef::fromStack (m_L);
-  }
-
-  template <class P1, class P2, class P3, class P4>
-  LuaRef operator() (P1 p1, P2 p2, P3 p3, P4 p4) const
+  template <class... Params>
+  LuaRef operator() (Params... params) const
   {
-    impl ().push ();;
-    Stack <P1>::push (m_L, p1);
-    Stack <P2>::push (m_L, p2);
-    Stack <P3>::push (m_L, p3);
-    Stack <P4>::push (m_L, p4);
-    LuaException::pcall (m_L, 4, 1);
+    impl ().push ();
+    int const pushed [] = {0, (Stack <Params>::push (m_L, params), 0)...};
+    (void) pushed;
+    LuaException::pcall (m_L, int (sizeof... (Params)), 1);
     return LuaRef::fromStack (m_L);
   }
 
-  template <class P1, class P2, class P3, class P4, class P5>
-  LuaRef operator() (P1 p1, P2 p2, P3 p3, P4 p4, P5 p5) const
-  {
-    impl ().push ();;
-    Stack <P1>::push (m_L, p1);
-    Stack <P2>::push (m_L, p2);
-    Stack <P3>::push (m_L, p3);
-    Stack <P4>::push (m_L, p4);
-    Stack <P5>::push (m_L, p5);
-    LuaException::pcall (m_L, 5, 1);
-    return LuaRef::fromStack (m_L);
-  }
+  //----------------------------------------------------------------------------
+  /**
+      Call Lua code and get several results.
 
-  template <class P1, class P2, class P3, class P4, class P5, class P6>
-  LuaRef operator() (P1 p1, P2 p2, P3 p3, P4 p4, P5 p5, P6 p6) const
-  {
-    impl ().push ();;
-    Stack <P1>::push (m_L, p1);
-    Stack <P2>::push (m_L, p2);
-    Stack <P3>::push (m_L, p3);
-    Stack <P4>::push (m_L, p4);
-    Stack <P5>::push (m_L, p5);
-    Stack <P6>::push (m_L, p6);
-    LuaException::pcall (m_L, 6, 1);
-    return LuaRef::fromStack (m_L);
-  }
+      The Lua function is adjusted to return as many values as there are
+      result types, and they are returned as a tuple, without a LuaRef for
+      each. Missing values are nil. Use std::tie to assign the results to
+      existing variables:
 
-  template <class P1, class P2, class P3, class P4, class P5, class P6, class P7>
-  LuaRef operator() (P1 p1, P2 p2, P3 p3, P4 p4, P5 p5, P6 p6, P7 p7) const
-  {
-    impl ().push ();;
-    Stack <P1>::push (m_L, p1);
-    Stack <P2>::push (m_L, p2);
-    Stack <P3>::push (m_L, p3);
-    Stack <P4>::push (m_L, p4);
-    Stack <P5>::push (m_L, p5);
-    Stack <P6>::push (m_L, p6);
-    Stack <P7>::push (m_L, p7);
-    LuaException::pcall (m_L, 7, 1);
-    return LuaRef::fromStack (m_L);
-  }
+          std::tie (x, y) = getGlobal (L, "position").call <int, int> (id);
 
-  template <class P1, class P2, class P3, class P4, class P5, class P6, class P7, class P8>
-  LuaRef operator() (P1 p1, P2 p2, P3 p3, P4 p4, P5 p5, P6 p6, P7 p7, P8 p8) const
+      If an error occurs, a LuaException is thrown.
+  */
+  template <class... Results, class... Params>
+  std::tuple <Results...> call (Params... params) const
   {
+    int const top = lua_gettop (m_L);
     impl ().push ();
-    Stack <P1>::push (m_L, p1);
-    Stack <P2>::push (m_L, p2);
-    Stack <P3>::push (m_L, p3);
-    Stack <P4>::push (m_L, p4);
-    Stack <P5>::push (m_L, p5);
-    Stack <P6>::push (m_L, p6);
-    Stack <P7>::push (m_L, p7);
-    Stack <P8>::push (m_L, p8);
-    LuaException::pcall (m_L, 8, 1);
-    return LuaRef::fromStack (m_L);
+    int const pushed [] = {0, (Stack <Params>::push (m_L, params), 0)...};
+    (void) pushed;
+    LuaException::pcall (m_L, int (sizeof... (Params)), CallResults <Results...>::count);
+    return CallResults <Results...>::get (m_L, top);
   }
-  /** @} */
 
   //============================================================================
 
@@ -577,6 +534,8 @@ private:
 
     The reference is maintained for the lifetime of the C++ object.
 */
+class LuaStackRef;
+
 class LuaRef : public LuaRefBase <LuaRef, LuaRef>
 {
   //----------------------------------------------------------------------------
@@ -586,42 +545,187 @@ class LuaRef : public LuaRefBase <LuaRef, LuaRef>
   class Proxy : public LuaRefBase <Proxy, LuaRef>
   {
     friend class LuaRef;
+    friend class LuaStackRef;
+
+    /** How the table of a proxy is kept.
+    */
+    enum TableType
+    {
+      ownedTable,
+      borrowedTable,
+      stackTable
+    };
+
+    /** How the key of a proxy is kept.
+    */
+    enum KeyType
+    {
+      refKey,
+      stringKey,
+      integerKey
+    };
+
+    template <class T>
+    struct KeyTraits
+    {
+      typedef typename std::decay <T>::type Key;
+
+      // Only the string types themselves: LuaRef, proxies and stack refs
+      // convert to anything and are referenced.
+      static bool const isString =
+        std::is_same <Key, char const*>::value ||
+        std::is_same <Key, char*>::value ||
+        std::is_same <Key, std::string>::value;
+
+      static bool const isInteger =
+        std::is_integral <Key>::value &&
+        !std::is_same <Key, bool>::value &&
+        !std::is_same <Key, char>::value && // pushed as a string
+        (sizeof (Key) < sizeof (lua_Integer) ||
+         (sizeof (Key) == sizeof (lua_Integer) && std::is_signed <Key>::value));
+
+      static KeyType const type = isString ? stringKey : isInteger ? integerKey : refKey;
+    };
 
-  public:
     //--------------------------------------------------------------------------
     /**
-        Construct a Proxy from a table value.
+        Construct a Proxy from a table value and a key.
 
-        The table is in the registry, and the key is at the top of the stack.
-        The key is popped off the stack.
+        The table is a registry reference or an absolute stack index. An
+        owned reference is released by the proxy, a borrowed reference or a
+        stack slot must outlive it. String and integer keys are kept in the
+        proxy, other keys are put in the registry.
     */
-    Proxy (lua_State* L, int tableRef)
+    template <class T>
+    Proxy (lua_State* L, int table, TableType tableType, T const& key)
       : LuaRefBase (L)
-      , m_tableRef (LUA_NOREF)
-      , m_keyRef (luaL_ref (L, LUA_REGISTRYINDEX))
+      , m_table (table)
+      , m_tableType (tableType)
+      , m_keyType (KeyTraits <T>::type)
+      , m_keyRef (LUA_NOREF)
+      , m_integerKey (0)
+    {
+      setKey (key, std::integral_constant <KeyType, KeyTraits <T>::type> ());
+    }
+
+    template <class T>
+    void setKey (T const& key, std::integral_constant <KeyType, stringKey>)
+    {
+      setStringKey (key);
+    }
+
+    void setStringKey (std::string const& key)
+    {
+      m_stringKey = key;
+    }
+
+    /** A null pointer is pushed as nil, like Stack <char const*> does.
+    */
+    void setStringKey (char const* key)
+    {
+      if (key != 0)
+      {
+        m_stringKey = key;
+      }
+      else
+      {
+        m_keyType = refKey;
+        setKey (key, std::integral_constant <KeyType, refKey> ());
+      }
+    }
+
+    template <class T>
+    void setKey (T const& key, std::integral_constant <KeyType, integerKey>)
+    {
+      m_integerKey = static_cast <lua_Integer> (key);
+    }
+
+    template <class T>
+    void setKey (T const& key, std::integral_constant <KeyType, refKey>)
+    {
+      Stack <T>::push (m_L, key);
+      m_keyRef = luaL_ref (m_L, LUA_REGISTRYINDEX);
+    }
+
+    void pushTable () const
     {
-      lua_rawgeti (m_L, LUA_REGISTRYINDEX, tableRef);
-      m_tableRef = luaL_ref (L, LUA_REGISTRYINDEX);
+      if (m_tableType == stackTable)
+      {
+        lua_pushvalue (m_L, m_table);
+      }
+      else
+      {
+        lua_rawgeti (m_L, LUA_REGISTRYINDEX, m_table);
+      }
     }
 
+    void pushKey () const
+    {
+      switch (m_keyType)
+      {
+      case stringKey:
+        lua_pushlstring (m_L, m_stringKey.data (), m_stringKey.size ());
+        break;
+
+      case integerKey:
+        lua_pushinteger (m_L, m_integerKey);
+        break;
+
+      default:
+        lua_rawgeti (m_L, LUA_REGISTRYINDEX, m_keyRef);
+        break;
+      }
+    }
+
+  public:
     //--------------------------------------------------------------------------
     /**
         Create a Proxy via copy constructor.
 
-        It is best to avoid code paths that invoke this, because it creates
-        an extra temporary Lua reference. Typically this is done by passing
-        the Proxy parameter as a `const` reference.
+        The copy shares a borrowed table reference or stack slot with the
+        other proxy, and otherwise creates its own table reference.
     */
     Proxy (Proxy const& other)
       : LuaRefBase (other.m_L)
-      , m_tableRef (LUA_NOREF)
+      , m_table (other.m_table)
+      , m_tableType (other.m_tableType)
+      , m_keyType (other.m_keyType)
       , m_keyRef (LUA_NOREF)
+      , m_stringKey (other.m_stringKey)
+      , m_integerKey (other.m_integerKey)
     {
-      lua_rawgeti (m_L, LUA_REGISTRYINDEX, other.m_tableRef);
-      m_tableRef = luaL_ref (m_L, LUA_REGISTRYINDEX);
+      if (m_tableType == ownedTable)
+      {
+        lua_rawgeti (m_L, LUA_REGISTRYINDEX, other.m_table);
+        m_table = luaL_ref (m_L, LUA_REGISTRYINDEX);
+      }
+
+      if (m_keyType == refKey)
+      {
+        lua_rawgeti (m_L, LUA_REGISTRYINDEX, other.m_keyRef);
+        m_keyRef = luaL_ref (m_L, LUA_REGISTRYINDEX);
+      }
+    }
 
-      lua_rawgeti (m_L, LUA_REGISTRYINDEX, other.m_keyRef);
-      m_keyRef = luaL_ref (m_L, LUA_REGISTRYINDEX);
+    //--------------------------------------------------------------------------
+    /**
+        Create a Proxy taking over the references of another one.
+
+        No Lua reference is created or released. The other proxy is left
+        without references.
+    */
+    Proxy (Proxy&& other) noexcept
+      : LuaRefBase (other.m_L)
+      , m_table (other.m_table)
+      , m_tableType (other.m_tableType)
+      , m_keyType (other.m_keyType)
+      , m_keyRef (other.m_keyRef)
+      , m_stringKey (std::move (other.m_stringKey))
+      , m_integerKey (other.m_integerKey)
+    {
+      other.m_table = LUA_NOREF;
+      other.m_tableType = borrowedTable;
+      other.m_keyRef = LUA_NOREF;
     }
 
     //--------------------------------------------------------------------------
@@ -633,7 +737,33 @@ class LuaRef : public LuaRefBase <LuaRef, LuaRef>
     ~Proxy ()
     {
       luaL_unref (m_L, LUA_REGISTRYINDEX, m_keyRef);
-      luaL_unref (m_L, LUA_REGISTRYINDEX, m_tableRef);
+      if (m_tableType == ownedTable)
+      {
+        luaL_unref (m_L, LUA_REGISTRYINDEX, m_table);
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    /**
+        Assign the value of another table key to this table key.
+
+        Like any assignment to a proxy, this writes to the table rather than
+        rebinding the proxy, so the references are not moved even from an
+        rvalue. This may invoke metamethods.
+    */
+    Proxy& operator= (Proxy const& other)
+    {
+      StackPop p (m_L, 1);
+      pushTable ();
+      pushKey ();
+      other.push ();
+      lua_settable (m_L, -3);
+      return *this;
+    }
+
+    Proxy& operator= (Proxy&& other)
+    {
+      return *this = static_cast <Proxy const&> (other);
     }
 
     //--------------------------------------------------------------------------
@@ -646,8 +776,8 @@ class LuaRef : public LuaRefBase <LuaRef, LuaRef>
     Proxy& operator= (T v)
     {
       StackPop p (m_L, 1);
-      lua_rawgeti (m_L, LUA_REGISTRYINDEX, m_tableRef);
-      lua_rawgeti (m_L, LUA_REGISTRYINDEX, m_keyRef);
+      pushTable ();
+      pushKey ();
       Stack <T>::push (m_L, v);
       lua_settable (m_L, -3);
       return *this;
@@ -663,8 +793,8 @@ class LuaRef : public LuaRefBase <LuaRef, LuaRef>
     Proxy& rawset (T v)
     {
       StackPop p (m_L, 1);
-      lua_rawgeti (m_L, LUA_REGISTRYINDEX, m_tableRef);
-      lua_rawgeti (m_L, LUA_REGISTRYINDEX, m_keyRef);
+      pushTable ();
+      pushKey ();
       Stack <T>::push (m_L, v);
       lua_rawset (m_L, -3);
       return *this;
@@ -678,8 +808,8 @@ class LuaRef : public LuaRefBase <LuaRef, LuaRef>
 
     void push () const
     {
-      lua_rawgeti (m_L, LUA_REGISTRYINDEX, m_tableRef);
-      lua_rawgeti (m_L, LUA_REGISTRYINDEX, m_keyRef);
+      pushTable ();
+      pushKey ();
       lua_gettable (m_L, -2);
       lua_remove (m_L, -2); // remove the table
     }
@@ -688,7 +818,8 @@ class LuaRef : public LuaRefBase <LuaRef, LuaRef>
     /**
         Access a table value using a key.
 
-        This invokes metamethods.
+        This invokes metamethods. The value of this proxy is referenced once,
+        by the returned proxy.
     */
     template <class T>
     Proxy operator[] (T key) const
@@ -710,12 +841,17 @@ class LuaRef : public LuaRefBase <LuaRef, LuaRef>
     }
 
   private:
-    int m_tableRef;
+    int m_table;
+    TableType m_tableType;
+    KeyType m_keyType;
     int m_keyRef;
+    std::string m_stringKey;
+    lua_Integer m_integerKey;
   };
 
   friend struct Stack <Proxy>;
   friend struct Stack <Proxy&>;
+  friend class LuaStackRef;
 
   //----------------------------------------------------------------------------
   /**
@@ -796,6 +932,20 @@ public:
   {
   }
 
+  //----------------------------------------------------------------------------
+  /**
+      Take over the reference of another LuaRef.
+
+      No Lua reference is created or released. The other LuaRef is left
+      without reference and behaves as nil.
+  */
+  LuaRef (LuaRef&& other) noexcept
+    : LuaRefBase (other.m_L)
+    , m_ref (other.m_ref)
+  {
+    other.m_ref = LUA_NOREF;
+  }
+
   //----------------------------------------------------------------------------
   /**
       Destroy a reference.
@@ -873,6 +1023,25 @@ public:
     return *this;
   }
 
+  //----------------------------------------------------------------------------
+  /**
+      Move another LuaRef to this LuaRef.
+
+      The reference of this LuaRef is released and the one of the other
+      LuaRef is taken over, which is left without reference.
+  */
+  LuaRef& operator= (LuaRef&& rhs) noexcept
+  {
+    if (this != &rhs)
+    {
+      luaL_unref (m_L, LUA_REGISTRYINDEX, m_ref);
+      m_L = rhs.m_L;
+      m_ref = rhs.m_ref;
+      rhs.m_ref = LUA_NOREF;
+    }
+    return *this;
+  }
+
   //----------------------------------------------------------------------------
   /**
       Assign Proxy to this LuaRef.
@@ -932,13 +1101,27 @@ public:
   /**
       Access a table value using a key.
 
-      This invokes metamethods.
+      This invokes metamethods. The proxy borrows the reference of this
+      LuaRef, which must outlive it and not be assigned meanwhile. String
+      and integer keys create no reference either.
   */
   template <class T>
-  Proxy operator[] (T key) const
+  Proxy operator[] (T key) const&
   {
-    Stack <T>::push (m_L, key);
-    return Proxy (m_L, m_ref);
+    return Proxy (m_L, m_ref, Proxy::borrowedTable, key);
+  }
+
+  /**
+      Access a table value of a temporary LuaRef using a key.
+
+      The proxy takes over the reference of the temporary.
+  */
+  template <class T>
+  Proxy operator[] (T key) &&
+  {
+    Proxy proxy (m_L, m_ref, Proxy::ownedTable, key);
+    m_ref = LUA_NOREF;
+    return proxy;
   }
 
     //--------------------------------------------------------------------------
@@ -986,6 +1169,11 @@ struct Stack <LuaRef>
   {
     return LuaRef::fromStack (L, index);
   }
+
+  static bool isInstance (lua_State*, int)
+  {
+    return true;
+  }
 };
 
 //------------------------------------------------------------------------------
@@ -1003,6 +1191,104 @@ struct Stack <LuaRef::Proxy>
   }
 };
 
+//------------------------------------------------------------------------------
+/**
+    A view of a value on the Lua stack.
+
+    It offers the operations of a LuaRef, but refers to a stack slot instead
+    of the registry, so creating and destroying it costs nothing. It is valid
+    while the slot holds the value: as a parameter of a bound function, for
+    the duration of the call. Tables are indexed without registry references
+    for string and integer keys. Convert it to a LuaRef to keep the value.
+*/
+class LuaStackRef : public LuaRefBase <LuaStackRef, LuaRef>
+{
+public:
+  //----------------------------------------------------------------------------
+  /**
+      Create a view of the value at a stack index.
+  */
+  LuaStackRef (lua_State* L, int index)
+    : LuaRefBase (L)
+    , m_index (lua_absindex (L, index))
+  {
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+      Get the absolute stack index of the value.
+  */
+  int getIndex () const
+  {
+    return m_index;
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+      Push the value onto the Lua stack.
+  */
+  using LuaRefBase::push;
+
+  void push () const
+  {
+    lua_pushvalue (m_L, m_index);
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+      Access a table value using a key.
+
+      This invokes metamethods. The proxy refers to the stack slot, so it
+      must not be used after the view becomes invalid.
+  */
+  template <class T>
+  LuaRef::Proxy operator[] (T key) const
+  {
+    return LuaRef::Proxy (m_L, m_index, LuaRef::Proxy::stackTable, key);
+  }
+
+  //----------------------------------------------------------------------------
+  /**
+      Access a table value using a key.
+
+      The operation is raw, metamethods are not invoked. The result is
+      passed by value and may not be modified.
+  */
+  template <class T>
+  LuaRef rawget (T key) const
+  {
+    Stack <T>::push (m_L, key);
+    lua_rawget (m_L, m_index);
+    return LuaRef::fromStack (m_L);
+  }
+
+private:
+  int m_index;
+};
+
+//------------------------------------------------------------------------------
+/**
+ * Stack specialization for `LuaStackRef`.
+ */
+template <>
+struct Stack <LuaStackRef>
+{
+  static void push (lua_State* L, LuaStackRef const& v)
+  {
+    v.push (L);
+  }
+
+  static LuaStackRef get (lua_State* L, int index)
+  {
+    return LuaStackRef (L, index);
+  }
+
+  static bool isInstance (lua_State*, int)
+  {
+    return true;
+  }
+};
+
 //------------------------------------------------------------------------------
 /**
     Create a reference to a new, empty table.
@@ -31,9 +31,11 @@
 #pragma once
 
 #include <LuaBridge/detail/ClassInfo.h>
+#include <LuaBridge/detail/RegistrationOptions.h>
 #include <LuaBridge/detail/Security.h>
 #include <LuaBridge/detail/TypeTraits.h>
 
+#include <cstring>
 #include <stdexcept>
 #include <string>
 
@@ -131,8 +133,12 @@ class Namespace
       lua_pushcfunction (L, &CFunc::newindexObjectMetaMethod);
       rawsetfield (L, -2, "__newindex");
 
-      lua_newtable (L);
-      lua_rawsetp (L, -2, getPropgetKey ());
+      if (trueConst)
+      {
+        // The class table shares the propget table, see createClassTable ().
+        lua_newtable (L);
+        lua_rawsetp (L, -2, getPropgetKey ());
+      }
 
       if (Security::hideMetatables ())
       {
@@ -151,9 +157,14 @@ class Namespace
     {
       // Stack: namespace table (ns), const table (co)
 
-      // Class table is the same as const table except the propset table
+      // Class table is the same as const table except the propset table.
+      // Every getter is visible to const objects, so the propget table of
+      // the const table is shared rather than duplicated.
       createConstTable (name, false); // Stack: ns, co, cl
 
+      lua_rawgetp (L, -2, getPropgetKey ()); // Stack: ns, co, cl, propget table (pg)
+      lua_rawsetp (L, -2, getPropgetKey ()); // cl [propgetKey] = pg. Stack: ns, co, cl
+
       lua_newtable (L); // Stack: ns, co, cl, propset table (ps)
       lua_rawsetp (L, -2, getPropsetKey ()); // cl [propsetKey] = ps. Stack: ns, co, cl
 
@@ -205,6 +216,633 @@ class Namespace
       }
     }
 
+    //--------------------------------------------------------------------------
+    /**
+      Create the class record of a const or class table.
+
+      The table must already be linked to its parent table, if any.
+    */
+    static void createClassRecord (lua_State* L, int index, void const* classKey, bool isConst)
+    {
+      index = lua_absindex (L, index);
+
+      ClassRecord const* parent = 0;
+      lua_rawgetp (L, index, getParentKey ()); // Stack: parent table (pt) | nil
+      if (lua_istable (L, -1))
+      {
+        lua_rawgetp (L, -1, getClassRecordKey ()); // Stack: pt, parent record
+        parent = static_cast <ClassRecord const*> (lua_touserdata (L, -1));
+        assert (parent != 0);
+        lua_pop (L, 1); // Stack: pt
+      }
+      lua_pop (L, 1); // Stack: -
+
+      ClassRecord* const records = static_cast <ClassRecord*> (
+        lua_newuserdata (L, 2 * sizeof (ClassRecord))); // Stack: records
+      new (records) ClassRecord (classKey, parent, isConst);
+      new (records + 1) ClassRecord (classKey, parent, isConst, true);
+      lua_rawsetp (L, index, getClassRecordKey ()); // t [classRecordKey] = records. Stack: -
+    }
+
+    //--------------------------------------------------------------------------
+    /**
+      Create the class records of the const and class tables, and their
+      pointer metatables.
+    */
+    void createClassRecords (void const* classKey) const
+    {
+      // Stack: const table (co), class table (cl), static table (st)
+      createClassRecord (L, -3, classKey, true);
+      createClassRecord (L, -2, classKey, false);
+
+      updatePointerMetatable (L, -3);
+      updatePointerMetatable (L, -2);
+    }
+
+    //--------------------------------------------------------------------------
+    /**
+      Create or refresh the metatable of objects pushed by pointer for a
+      const or class table.
+
+      The pointer metatable holds the identity, type name, class record and
+      metamethods of the table, except __gc, and links back to the table for
+      the member lookups. Static tables are not affected.
+    */
+    static void updatePointerMetatable (lua_State* L, int index)
+    {
+      index = lua_absindex (L, index);
+
+      lua_rawgetp (L, index, getIdentityKey ()); // Stack: true | nil
+      bool const isObjectTable = lua_toboolean (L, -1) != 0;
+      lua_pop (L, 1); // Stack: -
+
+      if (!isObjectTable)
+      {
+        return;
+      }
+
+      lua_rawgetp (L, index, getPointerMetatableKey ()); // Stack: pointer mt (pm) | nil
+      if (lua_isnil (L, -1))
+      {
+        lua_pop (L, 1); // Stack: -
+        lua_newtable (L); // Stack: pm
+        lua_pushvalue (L, -1); // Stack: pm, pm
+        lua_rawsetp (L, index, getPointerMetatableKey ()); // t [pointerMetatableKey] = pm. Stack: pm
+      }
+      else
+      {
+        // Remove the metamethods of a previous update.
+        lua_pushnil (L); // Stack: pm, nil
+        while (lua_next (L, -2)) // Stack: pm, key, value
+        {
+          lua_pop (L, 1); // Stack: pm, key
+          if (lua_type (L, -1) == LUA_TSTRING)
+          {
+            lua_pushvalue (L, -1); // Stack: pm, key, key
+            lua_pushnil (L); // Stack: pm, key, key, nil
+            lua_rawset (L, -4); // pm [key] = nil. Stack: pm, key
+          }
+        }
+      }
+
+      lua_pushvalue (L, index); // Stack: pm, t
+      lua_rawsetp (L, -2, getObjectTableKey ()); // pm [objectTableKey] = t. Stack: pm
+
+      void* const keys [] = { getIdentityKey (), getTypeKey (), getClassRecordKey () };
+      for (int i = 0; i < 3; ++i)
+      {
+        lua_rawgetp (L, index, keys [i]); // Stack: pm, value
+        lua_rawsetp (L, -2, keys [i]); // pm [key] = value. Stack: pm
+      }
+
+      lua_pushnil (L); // Stack: pm, nil
+      while (lua_next (L, index)) // Stack: pm, key, value
+      {
+        if (lua_type (L, -2) == LUA_TSTRING &&
+            std::strncmp (lua_tostring (L, -2), "__", 2) == 0 &&
+            std::strcmp (lua_tostring (L, -2), "__gc") != 0)
+        {
+          lua_pushvalue (L, -2); // Stack: pm, key, value, key
+          lua_insert (L, -2); // Stack: pm, key, key, value
+          lua_rawset (L, -4); // pm [key] = value. Stack: pm, key
+        }
+        else
+        {
+          lua_pop (L, 1); // Stack: pm, key
+        }
+      }
+      lua_pop (L, 1); // Stack: -
+    }
+
+    //--------------------------------------------------------------------------
+    /**
+      Refresh the pointer metatables of the class on top of the stack and of
+      all the classes derived from it.
+    */
+    void updatePointerMetatables () const
+    {
+      pushStaticMetatable (); // Stack: co, cl, st, static metatable (mt)
+      forEachClassTable (L, -1, &updatePointerMetatable);
+      lua_pop (L, 1); // Stack: co, cl, st
+    }
+
+    //--------------------------------------------------------------------------
+    /**
+      Create a weak valued pointer cache in a const or class table.
+    */
+    static void createPointerCache (lua_State* L, int index)
+    {
+      index = lua_absindex (L, index);
+
+      lua_newtable (L); // Stack: cache
+      lua_newtable (L); // Stack: cache, cache metatable (cm)
+      lua_pushstring (L, "v");
+      rawsetfield (L, -2, "__mode"); // cm ["__mode"] = "v". Stack: cache, cm
+      lua_setmetatable (L, -2); // Stack: cache
+      lua_rawsetp (L, index, getPointerCacheKey ()); // t [pointerCacheKey] = cache. Stack: -
+    }
+
+    //--------------------------------------------------------------------------
+    /**
+      Determine if a const or class table has a pointer cache.
+    */
+    static bool hasPointerCache (lua_State* L, int index)
+    {
+      lua_rawgetp (L, index, getPointerCacheKey ()); // Stack: cache | nil
+      bool const result = lua_istable (L, -1);
+      lua_pop (L, 1); // Stack: -
+      return result;
+    }
+
+    //--------------------------------------------------------------------------
+    /**
+      Determine if a class or one of the classes derived from it has a
+      pointer cache.
+
+      The static table of the class is at the given index.
+    */
+    static bool hasDerivedPointerCache (lua_State* L, int staticIndex)
+    {
+      luaL_checkstack (L, 8, "too many nested derived classes");
+
+      staticIndex = lua_absindex (L, staticIndex);
+
+      lua_rawgetp (L, staticIndex, getClassKey ()); // Stack: class table (cl)
+      assert (lua_istable (L, -1));
+      lua_rawgetp (L, -1, getConstKey ()); // Stack: cl, const table (co)
+      assert (lua_istable (L, -1));
+
+      bool result = hasPointerCache (L, -1) || hasPointerCache (L, -2);
+      lua_pop (L, 2); // Stack: -
+
+      lua_rawgetp (L, staticIndex, getDerivedKey ()); // Stack: derived set (ds) | nil
+      if (!result && lua_istable (L, -1))
+      {
+        lua_pushnil (L); // Stack: ds, nil
+        while (lua_next (L, -2)) // Stack: ds, derived static table (dst), true
+        {
+          lua_pop (L, 1); // Stack: ds, dst
+          if (hasDerivedPointerCache (L, -1))
+          {
+            lua_pop (L, 1); // Stack: ds
+            result = true;
+            break;
+          }
+        }
+      }
+      lua_pop (L, 1); // Stack: -
+      return result;
+    }
+
+    //--------------------------------------------------------------------------
+    /**
+      Determine if a const or class table, or one of its parents, allows
+      objects to have their own fields.
+    */
+    static bool hasObjectFields (lua_State* L, int index)
+    {
+      lua_pushvalue (L, index); // Stack: table (t)
+      for (;;)
+      {
+        lua_rawgetp (L, -1, getObjectFieldsKey ()); // Stack: t, true | nil
+        bool const result = lua_toboolean (L, -1) != 0;
+        lua_pop (L, 1); // Stack: t
+
+        lua_rawgetp (L, -1, getParentKey ()); // Stack: t, parent table | nil
+        lua_remove (L, -2); // Stack: parent table | nil
+        if (result || lua_isnil (L, -1))
+        {
+          lua_pop (L, 1); // Stack: -
+          return result;
+        }
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    /**
+      Copy the members of the source table missing in the destination table.
+
+      The names of the copied members are remembered in the destination
+      table so that they can be removed later by unflattenTable (). Members
+      found in the optional shadow table (a propget table) are not copied.
+    */
+    static void copyMissingMembers (lua_State* L, int src, int dst, bool skipMetamethods, int shadow = 0)
+    {
+      luaL_checkstack (L, 6, "too many nested base classes");
+
+      src = lua_absindex (L, src);
+      dst = lua_absindex (L, dst);
+      if (shadow != 0)
+      {
+        shadow = lua_absindex (L, shadow);
+      }
+
+      lua_rawgetp (L, dst, getFlattenedKey ()); // Stack: flattened names (fn) | nil
+      if (lua_isnil (L, -1))
+      {
+        lua_pop (L, 1); // Stack: -
+        lua_newtable (L); // Stack: fn
+        lua_pushvalue (L, -1); // Stack: fn, fn
+        lua_rawsetp (L, dst, getFlattenedKey ()); // dst [flattenedKey] = fn. Stack: fn
+      }
+
+      lua_pushnil (L); // Stack: fn, nil
+      while (lua_next (L, src)) // Stack: fn, key, value
+      {
+        if (lua_type (L, -2) == LUA_TSTRING &&
+            !(skipMetamethods && std::strncmp (lua_tostring (L, -2), "__", 2) == 0))
+        {
+          lua_pushvalue (L, -2); // Stack: fn, key, value, key
+          lua_rawget (L, dst); // Stack: fn, key, value, dst value | nil
+          bool isMissing = lua_isnil (L, -1);
+          lua_pop (L, 1); // Stack: fn, key, value
+
+          if (isMissing && shadow != 0)
+          {
+            lua_pushvalue (L, -2); // Stack: fn, key, value, key
+            lua_rawget (L, shadow); // Stack: fn, key, value, shadow value | nil
+            isMissing = lua_isnil (L, -1);
+            lua_pop (L, 1); // Stack: fn, key, value
+          }
+
+          if (isMissing)
+          {
+            lua_pushvalue (L, -2); // Stack: fn, key, value, key
+            lua_pushvalue (L, -2); // Stack: fn, key, value, key, value
+            lua_rawset (L, dst); // dst [key] = value. Stack: fn, key, value
+
+            lua_pushvalue (L, -2); // Stack: fn, key, value, key
+            lua_pushboolean (L, 1); // Stack: fn, key, value, key, true
+            lua_rawset (L, -5); // fn [key] = true. Stack: fn, key, value
+          }
+        }
+        lua_pop (L, 1); // Stack: fn, key
+      }
+      lua_pop (L, 1); // Stack: -
+    }
+
+    //--------------------------------------------------------------------------
+    /**
+      Copy the members of a propget or propset table of every base class
+      into the corresponding table of the class.
+    */
+    static void copyMissingProperties (lua_State* L, int src, int dst, void const* key)
+    {
+      src = lua_absindex (L, src);
+      dst = lua_absindex (L, dst);
+
+      lua_rawgetp (L, dst, key); // Stack: dst props | nil
+      lua_rawgetp (L, src, key); // Stack: dst props | nil, src props | nil
+      if (lua_istable (L, -1) && lua_istable (L, -2))
+      {
+        copyMissingMembers (L, -1, -2, false);
+      }
+      lua_pop (L, 2); // Stack: -
+    }
+
+    //--------------------------------------------------------------------------
+    /**
+      Copy the inherited members into a const, class or static table.
+
+      Methods, propget and propset entries of every base class which are not
+      overridden are copied, so that a lookup never has to visit the parents.
+
+      A class table shares the propget table of its const table, so it is
+      flattened along with the const table, one base class at a time.
+    */
+    static void flattenTable (lua_State* L, int index)
+    {
+      index = lua_absindex (L, index);
+
+      lua_rawgetp (L, index, getConstKey ()); // Stack: const table | nil
+      bool const isClassTable = lua_istable (L, -1);
+      lua_rawgetp (L, index, getIdentityKey ()); // Stack: const table | nil, true | nil
+      bool const isConstTable = !isClassTable && lua_toboolean (L, -1) != 0;
+      lua_pop (L, 2); // Stack: -
+
+      if (isClassTable)
+      {
+        return;
+      }
+
+      // Own properties take precedence over inherited methods.
+      lua_rawgetp (L, index, getPropgetKey ()); // Stack: propget table (pg) | nil
+      int const shadow = lua_istable (L, -1) ? lua_gettop (L) : 0;
+
+      if (isConstTable)
+      {
+        lua_rawgetp (L, index, getClassKey ()); // Stack: pg, class table (cl)
+      }
+      else
+      {
+        lua_pushnil (L); // Stack: pg, nil
+      }
+      int const classIndex = isConstTable ? lua_gettop (L) : 0;
+
+      lua_rawgetp (L, index, getParentKey ()); // Stack: pg, cl | nil, parent table (pt) | nil
+      while (lua_istable (L, -1))
+      {
+        copyMissingMembers (L, -1, index, true, shadow);
+
+        if (classIndex != 0)
+        {
+          lua_rawgetp (L, -1, getClassKey ()); // Stack: pg, cl, pt, parent class table (pcl)
+          copyMissingMembers (L, -1, classIndex, true, shadow);
+          copyMissingProperties (L, -1, classIndex, getPropsetKey ());
+          lua_pop (L, 1); // Stack: pg, cl, pt
+        }
+
+        copyMissingProperties (L, -1, index, getPropgetKey ());
+        copyMissingProperties (L, -1, index, getPropsetKey ());
+
+        lua_rawgetp (L, -1, getParentKey ()); // Stack: pg, cl | nil, pt, grand parent table | nil
+        lua_remove (L, -2);
+      }
+      lua_pop (L, 3); // Stack: -
+    }
+
+    //--------------------------------------------------------------------------
+    /**
+      Remove the members copied by copyMissingMembers ().
+    */
+    static void removeCopiedMembers (lua_State* L, int index)
+    {
+      index = lua_absindex (L, index);
+
+      lua_rawgetp (L, index, getFlattenedKey ()); // Stack: flattened names (fn) | nil
+      if (lua_istable (L, -1))
+      {
+        lua_pushnil (L); // Stack: fn, nil
+        while (lua_next (L, -2)) // Stack: fn, key, true
+        {
+          lua_pop (L, 1); // Stack: fn, key
+          lua_pushvalue (L, -1); // Stack: fn, key, key
+          lua_pushnil (L); // Stack: fn, key, key, nil
+          lua_rawset (L, index); // table [key] = nil. Stack: fn, key
+        }
+
+        lua_pushnil (L); // Stack: fn, nil
+        lua_rawsetp (L, index, getFlattenedKey ()); // table [flattenedKey] = nil. Stack: fn
+      }
+      lua_pop (L, 1); // Stack: -
+    }
+
+    //--------------------------------------------------------------------------
+    /**
+      Remove the inherited members copied by flattenTable ().
+    */
+    static void unflattenTable (lua_State* L, int index)
+    {
+      index = lua_absindex (L, index);
+
+      removeCopiedMembers (L, index);
+
+      lua_rawgetp (L, index, getPropgetKey ()); // Stack: propget table | nil
+      if (lua_istable (L, -1))
+      {
+        removeCopiedMembers (L, -1);
+      }
+      lua_pop (L, 1); // Stack: -
+
+      lua_rawgetp (L, index, getPropsetKey ()); // Stack: propset table | nil
+      if (lua_istable (L, -1))
+      {
+        removeCopiedMembers (L, -1);
+      }
+      lua_pop (L, 1); // Stack: -
+    }
+
+    //--------------------------------------------------------------------------
+    /**
+      Apply a function to the const, class and static tables of a class and
+      of all the classes derived from it.
+
+      The static table of the class is at the given index.
+    */
+    static void forEachClassTable (lua_State* L, int staticIndex, void (*fn) (lua_State*, int))
+    {
+      luaL_checkstack (L, 8, "too many nested derived classes");
+
+      staticIndex = lua_absindex (L, staticIndex);
+
+      lua_rawgetp (L, staticIndex, getClassKey ()); // Stack: class table (cl)
+      assert (lua_istable (L, -1));
+      lua_rawgetp (L, -1, getConstKey ()); // Stack: cl, const table (co)
+      assert (lua_istable (L, -1));
+
+      fn (L, -1); // const table
+      fn (L, -2); // class table
+      lua_pop (L, 2); // Stack: -
+      fn (L, staticIndex); // static table
+
+      lua_rawgetp (L, staticIndex, getDerivedKey ()); // Stack: derived set (ds) | nil
+      if (lua_istable (L, -1))
+      {
+        lua_pushnil (L); // Stack: ds, nil
+        while (lua_next (L, -2)) // Stack: ds, derived static table (dst), true
+        {
+          lua_pop (L, 1); // Stack: ds, dst
+          forEachClassTable (L, -1, fn);
+        }
+      }
+      lua_pop (L, 1); // Stack: -
+    }
+
+    //--------------------------------------------------------------------------
+    /**
+      Copy the inherited members into the tables of a class on top of the
+      stack and of all the classes derived from it.
+    */
+    void flattenClassTables () const
+    {
+      pushStaticMetatable (); // Stack: co, cl, st, static metatable (mt)
+      forEachClassTable (L, -1, &unflattenTable);
+      forEachClassTable (L, -1, &flattenTable);
+      lua_pop (L, 1); // Stack: co, cl, st
+    }
+
+    //--------------------------------------------------------------------------
+    /**
+      Remove the copied inherited members from the tables of a class on top
+      of the stack and of all the classes derived from it.
+
+      This is done when a class is reopened for registrations, so that new or
+      replaced members are seen by the derived classes.
+    */
+    void unflattenClassTables () const
+    {
+      pushStaticMetatable (); // Stack: co, cl, st, static metatable (mt)
+      forEachClassTable (L, -1, &unflattenTable);
+      lua_pop (L, 1); // Stack: co, cl, st
+    }
+
+    //--------------------------------------------------------------------------
+    /**
+      Push the table holding the static members and the class links.
+
+      A reopened class has the visible static table on the stack instead of
+      its metatable.
+    */
+    void pushStaticMetatable () const
+    {
+      // Stack: const table (co), class table (cl), static table (st)
+      lua_rawgetp (L, -1, getClassKey ()); // Stack: co, cl, st, cl | nil
+      bool const isMetatable = lua_istable (L, -1);
+      lua_pop (L, 1); // Stack: co, cl, st
+
+      if (isMetatable || !lua_getmetatable (L, -1))
+      {
+        lua_pushvalue (L, -1); // Stack: co, cl, st, st
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    /**
+      Determine whether the objects using a const or class table can have
+      their members looked up by the Lua VM through plain tables.
+
+      That requires that no table in the hierarchy has instance properties
+      or object fields, which need the object itself, or a user defined
+      __index metamethod.
+    */
+    static bool canIndexMethodTable (lua_State* L, int index)
+    {
+      index = lua_absindex (L, index);
+
+      lua_pushvalue (L, index); // Stack: table (t)
+      for (;;)
+      {
+        rawgetfield (L, -1, "__index"); // Stack: t, __index
+        bool const isDefaultIndex =
+          lua_rawequal (L, -1, -2) ||
+          lua_tocfunction (L, -1) == &CFunc::indexMetaMethod;
+        lua_pop (L, 1); // Stack: t
+
+        lua_rawgetp (L, -1, getPropgetKey ()); // Stack: t, propget table (pg)
+        assert (lua_istable (L, -1));
+        lua_pushnil (L); // Stack: t, pg, nil
+        bool const hasProperties = lua_next (L, -2) != 0; // Stack: t, pg [, key, value]
+        lua_pop (L, hasProperties ? 3 : 1); // Stack: t
+
+        lua_rawgetp (L, -1, getObjectFieldsKey ()); // Stack: t, true | nil
+        bool const hasObjectFields = lua_toboolean (L, -1) != 0;
+        lua_pop (L, 1); // Stack: t
+
+        if (!isDefaultIndex || hasProperties || hasObjectFields)
+        {
+          lua_pop (L, 1); // Stack: -
+          return false;
+        }
+
+        lua_rawgetp (L, -1, getParentKey ()); // Stack: t, parent table | nil
+        lua_remove (L, -2); // Stack: parent table | nil
+        if (lua_isnil (L, -1))
+        {
+          lua_pop (L, 1); // Stack: -
+          return true;
+        }
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    /**
+      Make a const or class table its own __index, when possible.
+
+      Method lookups are then done by the VM without calling into C. Missing
+      members are looked up in the parent table through a fallback metatable.
+      Static tables are not affected.
+    */
+    static void setMethodTableIndex (lua_State* L, int index)
+    {
+      index = lua_absindex (L, index);
+
+      lua_rawgetp (L, index, getIdentityKey ()); // Stack: true | nil
+      bool const isObjectTable = lua_toboolean (L, -1) != 0;
+      lua_pop (L, 1); // Stack: -
+
+      if (!isObjectTable || !canIndexMethodTable (L, index))
+      {
+        return;
+      }
+
+      lua_pushvalue (L, index); // Stack: t
+      rawsetfield (L, index, "__index"); // t.__index = t. Stack: -
+
+      lua_newtable (L); // Stack: fallback metatable (fb)
+      lua_rawgetp (L, index, getParentKey ()); // Stack: fb, parent table | nil
+      rawsetfield (L, -2, "__index"); // fb.__index = parent table. Stack: fb
+      lua_setmetatable (L, index); // t.__metatable = fb. Stack: -
+    }
+
+    //--------------------------------------------------------------------------
+    /**
+      Restore the __index metamethod of a const or class table made its own
+      __index by setMethodTableIndex ().
+    */
+    static void setFunctionIndex (lua_State* L, int index)
+    {
+      index = lua_absindex (L, index);
+
+      rawgetfield (L, index, "__index"); // Stack: __index
+      bool const isMethodTable = lua_rawequal (L, -1, index) != 0;
+      lua_pop (L, 1); // Stack: -
+
+      if (!isMethodTable)
+      {
+        return;
+      }
+
+      lua_pushcfunction (L, &CFunc::indexMetaMethod); // Stack: function
+      rawsetfield (L, index, "__index"); // t.__index = function. Stack: -
+
+      lua_pushvalue (L, index); // Stack: t
+      lua_setmetatable (L, index); // t.__metatable = t. Stack: -
+    }
+
+    //--------------------------------------------------------------------------
+    /**
+      Let the Lua VM look up the methods of the class on top of the stack and
+      of all the classes derived from it, where their hierarchy allows it.
+    */
+    void setMethodTableIndexes () const
+    {
+      pushStaticMetatable (); // Stack: co, cl, st, static metatable (mt)
+      forEachClassTable (L, -1, &setMethodTableIndex);
+      lua_pop (L, 1); // Stack: co, cl, st
+    }
+
+    //--------------------------------------------------------------------------
+    /**
+      Restore the __index metamethods of the class on top of the stack and of
+      all the classes derived from it, while the class is being registered.
+    */
+    void setFunctionIndexes () const
+    {
+      pushStaticMetatable (); // Stack: co, cl, st, static metatable (mt)
+      forEachClassTable (L, -1, &setFunctionIndex);
+      lua_pop (L, 1); // Stack: co, cl, st
+    }
+
     //==========================================================================
     /**
       lua_CFunction to construct a class object wrapped in a container.
@@ -216,6 +854,7 @@ class Namespace
       ArgList <Params, 2> args (L);
       T* const p = Constructor <T, Params>::call (args);
       UserdataSharedHelper <C, false>::push (L, p);
+      reportExternalMemory (L, ExternalMemoryTraits <T>::size (*p));
       return 1;
     }
 
@@ -227,7 +866,8 @@ class Namespace
     static int ctorPlacementProxy (lua_State* L)
     {
       ArgList <Params, 2> args (L);
-      Constructor <T, Params>::call (UserdataValue <T>::place (L), args);
+      T* const object = Constructor <T, Params>::call (UserdataValue <T>::place (L), args);
+      reportExternalMemory (L, ExternalMemoryTraits <T>::size (*object));
       return 1;
     }
 
@@ -323,6 +963,8 @@ class Namespace
         lua_rawsetp (L, LUA_REGISTRYINDEX, ClassInfo <T>::getClassKey ()); // Stack: ns, co, cl, st
         lua_pushvalue (L, -3); // Stack: ns, co, cl, st, co
         lua_rawsetp (L, LUA_REGISTRYINDEX, ClassInfo <T>::getConstKey ()); // Stack: ns, co, cl, st
+
+        createClassRecords (ClassInfo <T>::getClassKey ());
       }
       else
       {
@@ -337,6 +979,10 @@ class Namespace
         lua_insert (L, -2); // Stack: ns, co, cl, st
 
         m_stackSize = 3;
+
+        unflattenClassTables ();
+        setFunctionIndexes ();
+        updatePointerMetatables ();
       }
     }
 
@@ -371,6 +1017,19 @@ class Namespace
 
       assert (lua_istable (L, -1)); // Stack: ns, co, cl, st, pst
 
+      lua_rawgetp (L, -1, getDerivedKey ()); // Stack: ns, co, cl, st, pst, derived set (ds) | nil
+      if (lua_isnil (L, -1))
+      {
+        lua_pop (L, 1); // Stack: ns, co, cl, st, pst
+        lua_newtable (L); // Stack: ns, co, cl, st, pst, ds
+        lua_pushvalue (L, -1); // Stack: ns, co, cl, st, pst, ds, ds
+        lua_rawsetp (L, -3, getDerivedKey ()); // pst [derivedKey] = ds. Stack: ns, co, cl, st, pst, ds
+      }
+      lua_pushvalue (L, -3); // Stack: ns, co, cl, st, pst, ds, st
+      lua_pushboolean (L, 1); // Stack: ns, co, cl, st, pst, ds, st, true
+      lua_rawset (L, -3); // ds [st] = true. Stack: ns, co, cl, st, pst, ds
+      lua_pop (L, 1); // Stack: ns, co, cl, st, pst
+
       lua_rawgetp (L, -1, getClassKey ()); // Stack: ns, co, cl, st, pst, parent cl (pcl)
       assert (lua_istable (L, -1));
 
@@ -381,6 +1040,8 @@ class Namespace
       lua_rawsetp (L, -4, getParentKey ()); // cl [parentKey] = pcl. Stack: ns, co, cl, st, pst
       lua_rawsetp (L, -2, getParentKey ()); // st [parentKey] = pst. Stack: ns, co, cl, st
 
+      createClassRecords (ClassInfo <T>::getClassKey ());
+
       lua_pushvalue (L, -1); // Stack: ns, co, cl, st, st
       lua_rawsetp (L, LUA_REGISTRYINDEX, ClassInfo <T>::getStaticKey ()); // Stack: ns, co, cl, st
       lua_pushvalue (L, -2); // Stack: ns, co, cl, st, cl
@@ -395,6 +1056,12 @@ class Namespace
     */
     Namespace& endClass ()
     {
+      if (RegistrationOptions::flattenClassHierarchy ())
+      {
+        flattenClassTables ();
+      }
+      setMethodTableIndexes ();
+      updatePointerMetatables ();
       clearStack ();
       return m_parent;
     }
@@ -408,19 +1075,16 @@ class Namespace
     {
       assertStackState (); // Stack: const table (co), class table (cl), static table (st)
 
-      lua_pushlightuserdata (L, pu); // Stack: co, cl, st, pointer
-      lua_pushcclosure (L, &CFunc::getVariable <U>, 1); // Stack: co, cl, st, getter
+      CFunc::pushAccessor (L, &CFunc::getVariable <U>, pu); // Stack: co, cl, st, getter
       CFunc::addGetter (L, name, -2); // Stack: co, cl, st
 
       if (isWritable)
       {
-        lua_pushlightuserdata (L, pu); // Stack: co, cl, st, ps, pointer
-        lua_pushcclosure (L, &CFunc::setVariable <U>, 1); // Stack: co, cl, st, ps, setter
+        CFunc::pushAccessor (L, &CFunc::setVariable <U>, pu); // Stack: co, cl, st, setter
       }
       else
       {
-        lua_pushstring (L, name); // Stack: co, cl, st, name
-        lua_pushcclosure (L, &CFunc::readOnlyError, 1); // Stack: co, cl, st, error_fn
+        CFunc::pushAccessor (L, &CFunc::readOnlyError); // Stack: co, cl, st, error_fn
       }
       CFunc::addSetter (L, name, -2); // Stack: co, cl, st
 
@@ -438,21 +1102,16 @@ class Namespace
     {
       assertStackState (); // Stack: const table (co), class table (cl), static table (st)
 
-      typedef U (*get_t) ();
-      new (lua_newuserdata (L, sizeof (get))) get_t (get); // Stack: co, cl, st, function ptr
-      lua_pushcclosure (L, &CFunc::Call <U (*) (void)>::f, 1); // Stack: co, cl, st, getter
+      CFunc::pushAccessor (L, &CFunc::callGetter <U>, get); // Stack: co, cl, st, getter
       CFunc::addGetter (L, name, -2); // Stack: co, cl, st
 
       if (set != 0)
       {
-        typedef void (*set_t) (U);
-        new (lua_newuserdata (L, sizeof (set))) set_t (set); // Stack: co, cl, st, function ptr
-        lua_pushcclosure (L, &CFunc::Call <void (*) (U)>::f, 1); // Stack: co, cl, st, setter
+        CFunc::pushAccessor (L, &CFunc::callSetter <U>, set); // Stack: co, cl, st, setter
       }
       else
       {
-        lua_pushstring (L, name); // Stack: co, cl, st, ps, name
-        lua_pushcclosure (L, &CFunc::readOnlyError, 1); // Stack: co, cl, st, error_fn
+        CFunc::pushAccessor (L, &CFunc::readOnlyError); // Stack: co, cl, st, error_fn
       }
       CFunc::addSetter (L, name, -2); // Stack: co, cl, st
 
@@ -475,6 +1134,41 @@ class Namespace
       return *this;
     }
 
+    //--------------------------------------------------------------------------
+    /**
+      Add or replace an overloaded static member function.
+
+      The first overload matching the number and the types of the arguments
+      is called.
+    */
+    template <class FP1, class FP2, class... FPs>
+    Class <T>& addStaticFunction (char const* name, FP1 const fp1, FP2 const fp2, FPs const... fps)
+    {
+      assertStackState (); // Stack: const table (co), class table (cl), static table (st)
+
+      CFunc::pushOverloads <CFunc::CallOverload> (L, fp1, fp2, fps...); // co, cl, st, function
+      rawsetfield (L, -2, name); // co, cl, st
+
+      return *this;
+    }
+
+#ifdef LUABRIDGE_CXX17
+    //--------------------------------------------------------------------------
+    /**
+      Add or replace a static member function known at compile time.
+    */
+    template <auto fp>
+    Class <T>& addStaticFunction (char const* name)
+    {
+      assertStackState (); // Stack: const table (co), class table (cl), static table (st)
+
+      lua_pushcfunction (L, &CFunc::InlineCall <fp>::f); // co, cl, st, function
+      rawsetfield (L, -2, name); // co, cl, st
+
+      return *this;
+    }
+#endif
+
     //--------------------------------------------------------------------------
     /**
       Add or replace a lua_CFunction.
@@ -498,17 +1192,13 @@ class Namespace
     {
       assertStackState (); // Stack: const table (co), class table (cl), static table (st)
 
-      typedef const U T::*mp_t;
-      new (lua_newuserdata (L, sizeof (mp_t))) mp_t (mp); // Stack: co, cl, st, field ptr
-      lua_pushcclosure (L, &CFunc::getProperty <T, U>, 1); // Stack: co, cl, st, getter
-      lua_pushvalue (L, -1); // Stack: co, cl, st, getter, getter
-      CFunc::addGetter (L, name, -5); // Stack: co, cl, st, getter
+      typedef U T::*mp_t;
+      CFunc::pushAccessor (L, &CFunc::getProperty <T, U>, const_cast <mp_t> (mp)); // Stack: co, cl, st, getter
       CFunc::addGetter (L, name, -3); // Stack: co, cl, st
 
       if (isWritable)
       {
-        new (lua_newuserdata (L, sizeof (mp_t))) mp_t (mp); // Stack: co, cl, st, field ptr
-        lua_pushcclosure (L, &CFunc::setProperty <T, U>, 1); // Stack: co, cl, st, setter
+        CFunc::pushAccessor (L, &CFunc::setProperty <T, U>, const_cast <mp_t> (mp)); // Stack: co, cl, st, setter
         CFunc::addSetter (L, name, -3); // Stack: co, cl, st
       }
 
@@ -526,9 +1216,7 @@ class Namespace
 
       addProperty (name, get); // Add getter
 
-      typedef void (T::* set_t) (TS);
-      new (lua_newuserdata (L, sizeof (set_t))) set_t (set); // Stack: co, cl, st, function ptr
-      lua_pushcclosure (L, &CFunc::CallMember <set_t>::f, 1); // Stack: co, cl, st, setter
+      CFunc::pushAccessor (L, &CFunc::callMemberSetter <T, TS>, set); // Stack: co, cl, st, setter
       CFunc::addSetter (L, name, -3); // Stack: co, cl, st
 
       return *this;
@@ -540,11 +1228,7 @@ class Namespace
     {
       assertStackState (); // Stack: const table (co), class table (cl), static table (st)
 
-      typedef TG (T::*get_t) () const;
-      new (lua_newuserdata (L, sizeof (get_t))) get_t (get); // Stack: co, cl, st, funcion ptr
-      lua_pushcclosure (L, &CFunc::CallConstMember <get_t>::f, 1); // Stack: co, cl, st, getter
-      lua_pushvalue (L, -1); // Stack: co, cl, st, getter, getter
-      CFunc::addGetter (L, name, -5); // Stack: co, cl, st, getter
+      CFunc::pushAccessor (L, &CFunc::callMemberGetter <T, TG>, get); // Stack: co, cl, st, getter
       CFunc::addGetter (L, name, -3); // Stack: co, cl, st
 
       return *this;
@@ -566,19 +1250,13 @@ class Namespace
     {
       assertStackState (); // Stack: const table (co), class table (cl), static table (st)
 
-      typedef TG (*get_t) (T const*);
-      new (lua_newuserdata (L, sizeof (get_t))) get_t (get); // Stack: co, cl, st,, fn ptr
-      lua_pushcclosure (L, &CFunc::Call <get_t>::f, 1); // Stack: co, cl, st,, getter
-      lua_pushvalue (L, -1); // Stack: co, cl, st,, getter, getter
-      CFunc::addGetter (L, name, -5); // Stack: co, cl, st,, getter
-      CFunc::addGetter (L, name, -3); // Stack: co, cl, st,
+      CFunc::pushAccessor (L, &CFunc::callProxyGetter <T, TG>, get); // Stack: co, cl, st, getter
+      CFunc::addGetter (L, name, -3); // Stack: co, cl, st
 
       if (set != 0)
       {
-        typedef void (*set_t) (T*, TS);
-        new (lua_newuserdata (L, sizeof (set_t))) set_t (set); // Stack: co, cl, st,, fn ptr
-        lua_pushcclosure (L, &CFunc::Call <set_t>::f, 1); // Stack: co, cl, st,, setter
-        CFunc::addSetter (L, name, -3); // Stack: co, cl, st,
+        CFunc::pushAccessor (L, &CFunc::callProxySetter <T, TS>, set); // Stack: co, cl, st, setter
+        CFunc::addSetter (L, name, -3); // Stack: co, cl, st
       }
 
       return *this;
@@ -602,6 +1280,75 @@ class Namespace
       return *this;
     }
 
+    //--------------------------------------------------------------------------
+    /**
+        Add or replace an overloaded member function.
+
+        The first overload matching the number and the types of the arguments
+        is called. Const objects only see the const overloads, and lose a
+        const method of the same name if there are none. Overload sets cannot
+        be bound with bindMethod or called with callEach.
+    */
+    template <class MemFn1, class MemFn2, class... MemFns>
+    Class <T>& addFunction (char const* name, MemFn1 mf1, MemFn2 mf2, MemFns... mfs)
+    {
+      assertStackState (); // Stack: const table (co), class table (cl), static table (st)
+
+      static const std::string GC = "__gc";
+      if (name == GC)
+      {
+        throw std::logic_error (GC + " metamethod registration is forbidden");
+      }
+
+      bool const isConst [] = {
+        FuncTraits <MemFn1>::isConstMemberFunction,
+        FuncTraits <MemFn2>::isConstMemberFunction,
+        FuncTraits <MemFns>::isConstMemberFunction... };
+      bool hasConstOverloads = false;
+      for (bool const overloadIsConst : isConst)
+      {
+        hasConstOverloads = hasConstOverloads || overloadIsConst;
+      }
+
+      CFunc::pushOverloads <CFunc::CallMemberOverload> (L, mf1, mf2, mfs...); // co, cl, st, function
+      if (hasConstOverloads)
+      {
+        lua_pushvalue (L, -1); // co, cl, st, function, function
+      }
+      else
+      {
+        lua_pushnil (L); // co, cl, st, function, nil
+      }
+      rawsetfield (L, -5, name); // co, cl, st, function
+      rawsetfield (L, -3, name); // co, cl, st
+
+      return *this;
+    }
+
+#ifdef LUABRIDGE_CXX17
+    //--------------------------------------------------------------------------
+    /**
+        Add or replace a member function known at compile time.
+
+        The function is bound in the template argument, for example
+        `addFunction <&A::f> ("f")`. The resulting lua_CFunction has no
+        upvalue and the call can be inlined.
+    */
+    template <auto mf>
+    Class <T>& addFunction (char const* name)
+    {
+      assertStackState (); // Stack: const table (co), class table (cl), static table (st)
+
+      static const std::string GC = "__gc";
+      if (name == GC)
+      {
+        throw std::logic_error (GC + " metamethod registration is forbidden");
+      }
+      CFunc::InlineCallMemberFunctionHelper <mf, FuncTraits <decltype (mf)>::isConstMemberFunction>::add (L, name);
+      return *this;
+    }
+#endif
+
     //--------------------------------------------------------------------------
     /**
         Add or replace a member lua_CFunction.
@@ -668,6 +1415,72 @@ class Namespace
 
       return *this;
     }
+
+    //--------------------------------------------------------------------------
+    /**
+      Allow the objects of the class and of its derived classes to have
+      their own fields.
+
+      Assigning a name which is not a member stores the value in a table
+      kept in the uservalue of the object, created on the first assignment.
+      Reading a name which is not a member looks it up in that table. The
+      fields belong to the userdata, so an object pushed again by pointer
+      has none. Const objects can only read their fields.
+
+      A class cannot both cache pointers and have object fields: see
+      cachePointers (). Throws std::logic_error if the class or one of its
+      derived classes caches pointers.
+    */
+    Class <T>& addObjectFields ()
+    {
+      assertStackState (); // Stack: const table (co), class table (cl), static table (st)
+
+      pushStaticMetatable (); // Stack: co, cl, st, static metatable (mt)
+      bool const hasCache = hasDerivedPointerCache (L, -1);
+      lua_pop (L, 1); // Stack: co, cl, st
+      if (hasCache)
+      {
+        throw std::logic_error ("object fields are forbidden for a class caching pointers");
+      }
+
+      lua_pushboolean (L, 1);
+      lua_rawsetp (L, -4, getObjectFieldsKey ()); // co [objectFieldsKey] = true
+      lua_pushboolean (L, 1);
+      lua_rawsetp (L, -3, getObjectFieldsKey ()); // cl [objectFieldsKey] = true
+
+      return *this;
+    }
+
+    //--------------------------------------------------------------------------
+    /**
+      Reuse the userdata of objects pushed by pointer or reference.
+
+      While the userdata of an object is alive in Lua, pushing the object
+      again returns the same userdata, so no garbage is created and the
+      values compare equal. The userdata are kept in weak tables, separate
+      for const and non-const objects. Derived classes do not inherit the
+      cache.
+
+      An object destroyed in C++ while its userdata is alive is replaced in
+      Lua by any object of the class created later at the same address.
+      Such an object would also inherit the fields of the destroyed one, so
+      the class and its bases must not have object fields: throws
+      std::logic_error if they do.
+    */
+    Class <T>& cachePointers ()
+    {
+      assertStackState (); // Stack: const table (co), class table (cl), static table (st)
+
+      if (hasObjectFields (L, -2))
+      {
+        throw std::logic_error ("pointer cache is forbidden for a class with object fields");
+      }
+
+      createPointerCache (L, -3);
+      createPointerCache (L, -2);
+
+      return *this;
+    }
   };
 
 private:
@@ -810,19 +1623,16 @@ public:
 
     assert (lua_istable (L, -1)); // Stack: namespace table (ns)
 
-    lua_pushlightuserdata (L, pt); // Stack: ns, pointer
-    lua_pushcclosure (L, &CFunc::getVariable <T>, 1); // Stack: ns, getter
+    CFunc::pushAccessor (L, &CFunc::getVariable <T>, pt); // Stack: ns, getter
     CFunc::addGetter (L, name, -2); // Stack: ns
 
     if (isWritable)
     {
-      lua_pushlightuserdata (L, pt); // Stack: ns, pointer
-      lua_pushcclosure (L, &CFunc::setVariable <T>, 1); // Stack: ns, setter
+      CFunc::pushAccessor (L, &CFunc::setVariable <T>, pt); // Stack: ns, setter
     }
     else
     {
-      lua_pushstring (L, name); // Stack: ns, ps, name
-      lua_pushcclosure (L, &CFunc::readOnlyError, 1); // Stack: ns, error_fn
+      CFunc::pushAccessor (L, &CFunc::readOnlyError); // Stack: ns, error_fn
     }
     CFunc::addSetter (L, name, -2); // Stack: ns
 
@@ -845,23 +1655,18 @@ public:
 
     assert (lua_istable (L, -1)); // Stack: namespace table (ns)
 
-    typedef TG (*get_t) ();
-    new (lua_newuserdata (L, sizeof (get_t))) get_t (get); // Stack: ns, field ptr
-    lua_pushcclosure (L, &CFunc::Call <TG (*) (void)>::f, 1); // Stack: ns, getter
-    CFunc::addGetter (L, name, -2);
+    CFunc::pushAccessor (L, &CFunc::callGetter <TG>, get); // Stack: ns, getter
+    CFunc::addGetter (L, name, -2); // Stack: ns
 
     if (set != 0)
     {
-      typedef void (*set_t) (TS);
-      new (lua_newuserdata (L, sizeof (set_t))) set_t (set);
-      lua_pushcclosure (L, &CFunc::Call <void (*) (TS)>::f, 1);
+      CFunc::pushAccessor (L, &CFunc::callSetter <TS>, set); // Stack: ns, setter
     }
     else
     {
-      lua_pushstring (L, name);
-      lua_pushcclosure (L, &CFunc::readOnlyError, 1);
+      CFunc::pushAccessor (L, &CFunc::readOnlyError); // Stack: ns, error_fn
     }
-    CFunc::addSetter (L, name, -2);
+    CFunc::addSetter (L, name, -2); // Stack: ns
 
     return *this;
   }
@@ -882,6 +1687,44 @@ public:
     return *this;
   }
 
+  //----------------------------------------------------------------------------
+  /**
+      Add or replace an overloaded free function.
+
+      The first overload matching the number and the types of the arguments
+      is called.
+  */
+  template <class FP1, class FP2, class... FPs>
+  Namespace& addFunction (char const* name, FP1 const fp1, FP2 const fp2, FPs const... fps)
+  {
+    assert (lua_istable (L, -1)); // Stack: namespace table (ns)
+
+    CFunc::pushOverloads <CFunc::CallOverload> (L, fp1, fp2, fps...); // Stack: ns, function
+    rawsetfield (L, -2, name); // Stack: ns
+
+    return *this;
+  }
+
+#ifdef LUABRIDGE_CXX17
+  //----------------------------------------------------------------------------
+  /**
+      Add or replace a free function known at compile time.
+
+      The function is bound in the template argument, for example
+      `addFunction <&f> ("f")`.
+  */
+  template <auto fp>
+  Namespace& addFunction (char const* name)
+  {
+    assert (lua_istable (L, -1)); // Stack: namespace table (ns)
+
+    lua_pushcfunction (L, &CFunc::InlineCall <fp>::f); // Stack: ns, function
+    rawsetfield (L, -2, name); // Stack: ns
+
+    return *this;
+  }
+#endif
+
   //----------------------------------------------------------------------------
   /**
       Add or replace a lua_CFunction.
@@ -933,4 +1776,87 @@ inline Namespace getGlobalNamespace (lua_State* L)
   return Namespace::getGlobalNamespace (L);
 }
 
+//------------------------------------------------------------------------------
+/**
+    lua_CFunction returning a member function bound to an object.
+
+    Register it with addCFunction to bind methods from Lua, for example
+    `local update = bind (object, "update")`. The result is called without
+    the object, `update (dt)`, and skips the method lookup and the type
+    check of the object. It keeps the object alive.
+*/
+inline int bindMethod (lua_State* L)
+{
+  return CFunc::bindMethod (L);
+}
+
+/**
+    Return a member function bound to an object.
+
+    If the object has no method with the name, a LuaException is thrown.
+*/
+inline LuaRef bindMethod (LuaRef const& object, char const* name)
+{
+  lua_State* const L = object.state ();
+  lua_pushcfunction (L, &CFunc::bindMethod);
+  object.push (L);
+  lua_pushstring (L, name);
+  LuaException::pcall (L, 2, 1);
+  return LuaRef::fromStack (L);
+}
+
+/**
+    lua_CFunction calling a member function on each object of an array.
+
+    Register it with addCFunction to call methods in batches from Lua, for
+    example `each (objects, "update", dt)`. The method is looked up once
+    from the first object and the arguments are converted once, then each
+    object is checked against the class of the method and called. The
+    results are discarded.
+*/
+inline int callEach (lua_State* L)
+{
+  return CFunc::callEach (L);
+}
+
+/**
+    Call a member function on each object of an array.
+
+    The objects can be a Lua table or a C++ container converted to one, such
+    as a LuaRef holding a std::vector of pointers. If the method is missing
+    or an object has the wrong type, a LuaException is thrown.
+*/
+template <class... Args>
+void callEach (LuaRef const& objects, char const* name, Args... args)
+{
+  lua_State* const L = objects.state ();
+  lua_pushcfunction (L, &CFunc::callEach);
+  objects.push (L);
+  lua_pushstring (L, name);
+  int const pushed [] = { 0, (Stack <Args>::push (L, args), 0)... };
+  (void) pushed;
+  LuaException::pcall (L, 2 + int (sizeof... (Args)), 0);
+}
+
+/**
+    Call a member function on each object between two C++ iterators.
+
+    The elements are pointers to objects or the objects themselves. The
+    method is looked up once in the class of the objects, and called on
+    them directly, without pushing them to Lua. Const objects only see
+    const methods. If the method is missing or an element is a null
+    pointer, a LuaException is thrown.
+*/
+template <class Iterator, class... Args>
+void callEach (lua_State* L, Iterator first, Iterator last, char const* name, Args... args)
+{
+  TypedObjectRange <Iterator> range (first, last);
+  lua_pushcfunction (L, &CFunc::callEachInRange);
+  lua_pushlightuserdata (L, static_cast <ObjectRange*> (&range));
+  lua_pushstring (L, name);
+  int const pushed [] = { 0, (Stack <Args>::push (L, args), 0)... };
+  (void) pushed;
+  LuaException::pcall (L, 2 + int (sizeof... (Args)), 0);
+}
+
 } // namespace luabridge
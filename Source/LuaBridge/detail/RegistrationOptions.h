@@ -0,0 +1,58 @@
+// https://github.com/vinniefalco/LuaBridge
+//
+// Copyright 2019, Dmitry Tarakanov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+namespace luabridge {
+
+//------------------------------------------------------------------------------
+/**
+  Options applied to class registrations.
+*/
+class RegistrationOptions
+{
+public:
+  static bool flattenClassHierarchy ()
+  {
+    return getSettings ().flattenClassHierarchy;
+  }
+
+  static void setFlattenClassHierarchy (bool shouldFlatten)
+  {
+    getSettings ().flattenClassHierarchy = shouldFlatten;
+  }
+
+private:
+  struct Settings
+  {
+    Settings ()
+      : flattenClassHierarchy (false)
+    {
+    }
+
+    bool flattenClassHierarchy;
+  };
+
+  static Settings& getSettings ()
+  {
+    static Settings settings;
+    return settings;
+  }
+};
+
+//------------------------------------------------------------------------------
+/**
+  Change whether or not inherited members are copied into derived class
+  tables when a class registration is closed (off by default).
+
+  Flattening makes member lookups on deeply derived objects a single table
+  hit at the expense of memory used by the class tables.
+*/
+inline void setFlattenClassHierarchy (bool shouldFlatten)
+{
+  RegistrationOptions::setFlattenClassHierarchy (shouldFlatten);
+}
+
+} // namespace luabridge
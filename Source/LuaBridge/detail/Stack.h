@@ -51,6 +51,11 @@ struct Stack <lua_State*>
   {
     return L;
   }
+
+  static bool isInstance (lua_State*, int)
+  {
+    return true;
+  }
 };
 
 //------------------------------------------------------------------------------
@@ -69,6 +74,11 @@ struct Stack <lua_CFunction>
   {
     return lua_tocfunction (L, index);
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return lua_iscfunction (L, index) != 0;
+  }
 };
 
 //------------------------------------------------------------------------------
@@ -87,6 +97,11 @@ struct Stack <int>
   {
     return static_cast <int> (luaL_checkinteger (L, index));
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return lua_type (L, index) == LUA_TNUMBER;
+  }
 };
 
 //------------------------------------------------------------------------------
@@ -105,6 +120,11 @@ struct Stack <unsigned int>
   {
     return static_cast <unsigned int> (luaL_checkinteger (L, index));
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return lua_type (L, index) == LUA_TNUMBER;
+  }
 };
 
 //------------------------------------------------------------------------------
@@ -123,6 +143,11 @@ struct Stack <unsigned char>
   {
     return static_cast <unsigned char> (luaL_checkinteger (L, index));
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return lua_type (L, index) == LUA_TNUMBER;
+  }
 };
 
 //------------------------------------------------------------------------------
@@ -141,6 +166,11 @@ struct Stack <short>
   {
     return static_cast <short> (luaL_checkinteger (L, index));
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return lua_type (L, index) == LUA_TNUMBER;
+  }
 };
 
 //------------------------------------------------------------------------------
@@ -159,6 +189,11 @@ struct Stack <unsigned short>
   {
     return static_cast <unsigned short> (luaL_checkinteger (L, index));
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return lua_type (L, index) == LUA_TNUMBER;
+  }
 };
 
 //------------------------------------------------------------------------------
@@ -177,6 +212,11 @@ struct Stack <long>
   {
     return static_cast <long> (luaL_checkinteger (L, index));
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return lua_type (L, index) == LUA_TNUMBER;
+  }
 };
 
 //------------------------------------------------------------------------------
@@ -195,6 +235,11 @@ struct Stack <unsigned long>
   {
     return static_cast <unsigned long> (luaL_checkinteger (L, index));
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return lua_type (L, index) == LUA_TNUMBER;
+  }
 };
 
 //------------------------------------------------------------------------------
@@ -212,6 +257,11 @@ struct Stack <long long>
   {
     return static_cast <long long> (luaL_checkinteger (L, index));
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return lua_type (L, index) == LUA_TNUMBER;
+  }
 };
 
 //------------------------------------------------------------------------------
@@ -229,6 +279,11 @@ struct Stack <unsigned long long>
   {
     return static_cast <unsigned long long> (luaL_checkinteger (L, index));
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return lua_type (L, index) == LUA_TNUMBER;
+  }
 };
 
 //------------------------------------------------------------------------------
@@ -247,6 +302,11 @@ struct Stack <float>
   {
     return static_cast <float> (luaL_checknumber (L, index));
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return lua_type (L, index) == LUA_TNUMBER;
+  }
 };
 
 //------------------------------------------------------------------------------
@@ -265,6 +325,11 @@ struct Stack <double>
   {
     return static_cast <double> (luaL_checknumber (L, index));
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return lua_type (L, index) == LUA_TNUMBER;
+  }
 };
 
 //------------------------------------------------------------------------------
@@ -283,6 +348,11 @@ struct Stack <bool>
   {
     return lua_toboolean (L, index) ? true : false;
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return lua_isboolean (L, index);
+  }
 };
 
 //------------------------------------------------------------------------------
@@ -301,6 +371,11 @@ struct Stack <char>
   {
     return luaL_checkstring (L, index) [0];
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return lua_type (L, index) == LUA_TSTRING;
+  }
 };
 
 //------------------------------------------------------------------------------
@@ -322,6 +397,11 @@ struct Stack <char const*>
   {
     return lua_isnil (L, index) ? 0 : luaL_checkstring (L, index);
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return lua_isnil (L, index) || lua_type (L, index) == LUA_TSTRING;
+  }
 };
 
 //------------------------------------------------------------------------------
@@ -342,6 +422,11 @@ struct Stack <std::string>
     const char *str = luaL_checklstring (L, index, &len);
     return std::string (str, len);
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return lua_type (L, index) == LUA_TSTRING;
+  }
 };
 
 
@@ -359,6 +444,11 @@ struct StackOpSelector <T&, false>
   {
     return Stack <T>::get (L, index);
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return Stack <T>::isInstance (L, index);
+  }
 };
 
 template <class T>
@@ -375,6 +465,11 @@ struct StackOpSelector <const T&, false>
   {
     return Stack <T>::get (L, index);
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return Stack <T>::isInstance (L, index);
+  }
 };
 
 template <class T>
@@ -391,6 +486,11 @@ struct StackOpSelector <T*, false>
   {
     return Stack <T>::get (L, index);
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return Stack <T>::isInstance (L, index);
+  }
 };
 
 template <class T>
@@ -407,6 +507,11 @@ struct StackOpSelector <const T*, false>
   {
     return Stack <T>::get (L, index);
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return Stack <T>::isInstance (L, index);
+  }
 };
 
 
@@ -425,6 +530,11 @@ struct Stack <T&>
   {
     return Helper::get (L, index);
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return Helper::isInstance (L, index);
+  }
 };
 
 template <class T>
@@ -442,6 +552,11 @@ struct Stack <const T&>
   {
     return Helper::get (L, index);
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return Helper::isInstance (L, index);
+  }
 };
 
 template <class T>
@@ -459,6 +574,11 @@ struct Stack <T*>
   {
     return Helper::get (L, index);
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return Helper::isInstance (L, index);
+  }
 };
 
 template <class T>
@@ -476,6 +596,11 @@ struct Stack <const T*>
   {
     return Helper::get (L, index);
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return Helper::isInstance (L, index);
+  }
 };
 
 } // namespace luabridge
@@ -47,8 +47,10 @@
 
 #include <LuaBridge/detail/Stack.h>
 
-#include <string>
-#include <typeinfo>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 namespace luabridge {
 
@@ -57,128 +59,232 @@ namespace luabridge {
 */
 typedef void None;
 
-template <typename Head, typename Tail = None>
+/**
+  A list of parameter types.
+*/
+template <class... Params>
 struct TypeList
 {
 };
 
+//==============================================================================
 /**
-  A TypeList with actual values.
+  A compile time sequence of indices, used to expand a TypeListValues into
+  an argument list.
 */
-template <typename List>
-struct TypeListValues
+template <std::size_t... Indices>
+struct IndexSequence
 {
-  static std::string const tostring (bool)
-  {
-    return "";
-  }
 };
 
+template <std::size_t N, std::size_t... Indices>
+struct MakeIndexSequence : MakeIndexSequence <N - 1, N - 1, Indices...>
+{
+};
+
+template <std::size_t... Indices>
+struct MakeIndexSequence <0, Indices...>
+{
+  typedef IndexSequence <Indices...> Type;
+};
+
+//==============================================================================
+/**
+  The type returned by Stack <T>::get ().
+
+  Registered classes passed by reference are returned as references to the
+  object kept in the userdata, everything else is returned by value.
+*/
+template <class T>
+struct StackValue
+{
+  typedef decltype (Stack <T>::get (std::declval <lua_State*> (), 0)) Type;
+};
+
+//==============================================================================
 /**
-  TypeListValues recursive template definition.
+  A TypeList with actual values.
+
+  Each value is stored as returned by Stack <T>::get (), so references to
+  registered classes bind straight to the userdata storage. Values owned by
+  the list are moved into the function call unless the parameter is a
+  non-const lvalue reference.
 */
-template <typename Head, typename Tail>
-struct TypeListValues <TypeList <Head, Tail> >
+template <class List>
+struct TypeListValues;
+
+template <class... Params>
+struct TypeListValues <TypeList <Params...> >
 {
-  Head hd;
-  TypeListValues <Tail> tl;
+  typedef std::tuple <typename StackValue <Params>::Type...> Values;
 
-  TypeListValues (Head hd_, TypeListValues <Tail> const& tl_)
-    : hd (hd_), tl (tl_)
+  template <class... Args>
+  explicit TypeListValues (Args&&... args)
+    : values (std::forward <Args> (args)...)
   {
   }
 
-  static std::string tostring (bool comma = false)
+  /** The type used to pass the value at index I to the function.
+  */
+  template <std::size_t I>
+  struct Forward
+  {
+    typedef typename std::tuple_element <I, std::tuple <Params...> >::type Param;
+    typedef typename std::tuple_element <I, Values>::type Value;
+    typedef typename std::conditional <
+      std::is_reference <Value>::value || std::is_lvalue_reference <Param>::value,
+      typename std::remove_reference <Value>::type&,
+      Value&&>::type Type;
+  };
+
+  template <std::size_t I>
+  typename Forward <I>::Type get ()
   {
-    std::string s;
+    return static_cast <typename Forward <I>::Type> (std::get <I> (values));
+  }
 
-    if (comma)
-      s = ", ";
+  /** The type used to pass the value at index I without moving from it.
+  */
+  template <std::size_t I>
+  struct Share
+  {
+    typedef typename std::tuple_element <I, std::tuple <Params...> >::type Param;
+    typedef typename std::tuple_element <I, Values>::type Value;
+    typedef typename std::conditional <
+      std::is_rvalue_reference <Param>::value && !std::is_reference <Value>::value,
+      typename std::remove_cv <Value>::type,
+      typename std::remove_reference <Value>::type&>::type Type;
+  };
+
+  template <std::size_t I>
+  typename Share <I>::Type getShared ()
+  {
+    return std::get <I> (values);
+  }
 
-    s = s + typeid (Head).name ();
+private:
+  TypeListValues (TypeListValues const&);
+  TypeListValues& operator= (TypeListValues const&);
 
-    return s + TypeListValues <Tail>::tostring (true);
-  }
+  Values values;
 };
 
-// Specializations of type/value list for head types that are references and
-// const-references.  We need to handle these specially since we can't count
-// on the referenced object hanging around for the lifetime of the list.
+//==============================================================================
+/**
+  The number of Lua arguments taken by a parameter. A lua_State* parameter
+  receives the state and takes none.
+*/
+template <class T>
+struct ArgWidth
+{
+  static int const value = 1;
+};
 
-template <typename Head, typename Tail>
-struct TypeListValues <TypeList <Head&, Tail> >
+template <>
+struct ArgWidth <lua_State*>
 {
-  Head hd;
-  TypeListValues <Tail> tl;
+  static int const value = 0;
+};
 
-  TypeListValues (Head& hd_, TypeListValues <Tail> const& tl_)
-    : hd (hd_), tl (tl_)
-  {
-  }
+/**
+  The number of Lua arguments taken by a TypeList.
+*/
+template <class List>
+struct ArgCount;
 
-  static std::string const tostring (bool comma = false)
-  {
-    std::string s;
+template <>
+struct ArgCount <TypeList <> >
+{
+  static int const value = 0;
+};
 
-    if (comma)
-      s = ", ";
+template <class Head, class... Tail>
+struct ArgCount <TypeList <Head, Tail...> >
+{
+  static int const value = ArgWidth <Head>::value + ArgCount <TypeList <Tail...> >::value;
+};
 
-    s = s + typeid (Head).name () + "&";
+/**
+  The stack index of the parameter I of a TypeList whose arguments start at
+  the index Start.
+*/
+template <class List, int Start, std::size_t I>
+struct ArgIndex;
 
-    return s + TypeListValues <Tail>::tostring (true);
-  }
+template <class Head, class... Tail, int Start>
+struct ArgIndex <TypeList <Head, Tail...>, Start, 0>
+{
+  static int const value = Start;
 };
 
-template <typename Head, typename Tail>
-struct TypeListValues <TypeList <Head const&, Tail> >
+template <class Head, class... Tail, int Start, std::size_t I>
+struct ArgIndex <TypeList <Head, Tail...>, Start, I>
 {
-  Head hd;
-  TypeListValues <Tail> tl;
+  static int const value =
+    ArgIndex <TypeList <Tail...>, Start + ArgWidth <Head>::value, I - 1>::value;
+};
+
+//==============================================================================
+/**
+  Checks the types of the values on the Lua stack against a TypeList,
+  starting at the index Start. No error is raised.
+*/
+template <class List, int Start>
+struct ArgTypes;
 
-  TypeListValues (Head const& hd_, const TypeListValues <Tail>& tl_)
-    : hd (hd_), tl (tl_)
+template <int Start>
+struct ArgTypes <TypeList <>, Start>
+{
+  static bool match (lua_State*)
   {
+    return true;
   }
+};
 
-  static std::string const tostring (bool comma = false)
+template <class Head, class... Tail, int Start>
+struct ArgTypes <TypeList <Head, Tail...>, Start>
+{
+  static bool match (lua_State* L)
   {
-    std::string s;
-
-    if (comma)
-      s = ", ";
-
-    s = s + typeid (Head).name () + " const&";
-
-    return s + TypeListValues <Tail>::tostring (true);
+    return Stack <Head>::isInstance (L, Start) &&
+      ArgTypes <TypeList <Tail...>, Start + ArgWidth <Head>::value>::match (L);
   }
 };
 
 //==============================================================================
 /**
   Subclass of a TypeListValues constructable from the Lua stack.
+
+  The arguments are read from the stack from left to right, starting at
+  the index Start. lua_State* parameters take no argument.
 */
+template <class List, int Start = 1>
+struct ArgList;
 
-template <typename List, int Start = 1>
-struct ArgList
+template <class... Params, int Start>
+struct ArgList <TypeList <Params...>, Start>
+  : public TypeListValues <TypeList <Params...> >
 {
-};
+  explicit ArgList (lua_State* L)
+    : ArgList (L, typename MakeIndexSequence <sizeof... (Params)>::Type ())
+  {
+  }
 
-template <int Start>
-struct ArgList <None, Start> : public TypeListValues <None>
-{
-  ArgList (lua_State*)
+  /** Determine if the Lua stack holds exactly the arguments of the list.
+  */
+  static bool matches (lua_State* L)
   {
+    return lua_gettop (L) == Start - 1 + ArgCount <TypeList <Params...> >::value &&
+      ArgTypes <TypeList <Params...>, Start>::match (L);
   }
-};
 
-template <typename Head, typename Tail, int Start>
-struct ArgList <TypeList <Head, Tail>, Start>
-  : public TypeListValues <TypeList <Head, Tail> >
-{
-  ArgList (lua_State* L)
-    : TypeListValues <TypeList <Head, Tail> > (Stack <Head>::get (L, Start),
-                                            ArgList <Tail, Start + 1> (L))
+private:
+  template <std::size_t... Indices>
+  ArgList (lua_State* L, IndexSequence <Indices...>)
+    : TypeListValues <TypeList <Params...> > {
+        Stack <Params>::get (L, ArgIndex <TypeList <Params...>, Start, Indices>::value)... }
   {
+    (void) L; // unused when there are no parameters
   }
 };
 
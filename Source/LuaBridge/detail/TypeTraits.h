@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <string>
 
 
@@ -65,6 +66,34 @@ struct ContainerTraits
   typedef T Type;
 };
 
+//------------------------------------------------------------------------------
+/**
+    External memory traits.
+
+    Class objects may own memory which Lua does not see, such as the buffer
+    of a std::vector, so collections would not keep up with the memory they
+    hold. A specialization reports the bytes owned by an object, which are
+    added to the debt of the garbage collector when the object is stored by
+    value in a userdata, or created by a constructor registered for a class:
+
+        template <>
+        struct ExternalMemoryTraits <Image>
+        {
+          static std::size_t size (Image const& image)
+          {
+            return image.pixels.capacity () * sizeof (Pixel);
+          }
+        };
+*/
+template <class T>
+struct ExternalMemoryTraits
+{
+  static std::size_t size (T const&)
+  {
+    return 0;
+  }
+};
+
 //------------------------------------------------------------------------------
 /**
     Type traits.
@@ -30,10 +30,14 @@
 #pragma once
 
 #include <LuaBridge/detail/ClassInfo.h>
+#include <LuaBridge/detail/HandleSlots.h>
 #include <LuaBridge/detail/TypeList.h>
 
 #include <cassert>
+#include <cstddef>
+#include <memory>
 #include <stdexcept>
+#include <type_traits>
 
 
 namespace luabridge {
@@ -63,20 +67,56 @@ namespace luabridge {
     7. Our lightuserdata is unique.
 */
 
+/**
+  Push onto the Lua stack the metatable of the value at the index, like
+  lua_getmetatable (). Returns 0 and pushes nothing if it has none.
+
+  The metatable of objects pushed by pointer is replaced by the class or
+  const table it was made from, which holds the members.
+*/
+inline int getObjectMetatable (lua_State* L, int index)
+{
+  if (!lua_getmetatable (L, index))
+    return 0;
+
+  lua_rawgetp (L, -1, getObjectTableKey ()); // Stack: mt, class/const table | nil
+  if (lua_istable (L, -1))
+    lua_remove (L, -2);
+  else
+    lua_pop (L, 1);
+  return 1;
+}
+
 /**
   Interface to a class pointer retrievable from a userdata.
+
+  The interface has no virtual functions, so that userdata holding a plain
+  pointer need no destructor. Userdata owning their object derive from
+  UserdataOwner.
 */
 class Userdata
 {
 protected:
   void* m_p; // subclasses must set this
+  ClassRecord const* m_class; // set by setMetatable ()
+
+  Userdata ()
+    : m_p (0)
+    , m_class (0)
+  {
+  }
 
   //--------------------------------------------------------------------------
   /**
     Get an untyped pointer to the contained class.
+
+    Handles are resolved through their slot, giving 0 once the object has
+    been destroyed.
   */
   inline void* const getPointer ()
   {
+    if (m_class != 0 && m_class->isHandle)
+      return static_cast <HandleBase const*> (m_p)->getObject ();
     return m_p;
   }
 
@@ -178,16 +218,72 @@ private:
 
     The Userdata must be derived from or the same as the given base class,
     identified by the key. If canBeConst is false, generates an error if
-    the resulting Userdata represents to a const object. We do the type check
-    first so that the error message is informative.
+    the resulting Userdata represents to a const object.
+
+    The metatable identity is checked on the Lua stack, then the class and
+    const-ness are checked against the class record kept in the Userdata.
+    Mismatches are reported by getClassChecked ().
   */
   static Userdata* getClass (lua_State* L,
                              int index,
                              void const* baseClassKey,
                              bool canBeConst)
+  {
+    Userdata* const ud = findClass (L, index, baseClassKey, canBeConst);
+    if (ud != 0)
+      return ud;
+
+    return getClassChecked (L, index, baseClassKey, canBeConst);
+  }
+
+  //--------------------------------------------------------------------------
+  /**
+    Retrieve a Userdata on the stack if it matches, without raising errors.
+
+    Returns 0 if the value is not one of our objects, is not derived from
+    the base class, or violates the const-ness.
+  */
+  static Userdata* findClass (lua_State* L,
+                              int index,
+                              void const* baseClassKey,
+                              bool canBeConst)
   {
     index = index > 0 ? index : lua_absindex (L, index);
 
+    if (lua_type (L, index) == LUA_TUSERDATA && lua_getmetatable (L, index))
+    {
+      lua_rawgetp (L, -1, getIdentityKey ());
+      bool const isOurs = lua_isboolean (L, -1);
+      lua_pop (L, 2);
+
+      if (isOurs)
+      {
+        Userdata* const ud = static_cast <Userdata*> (lua_touserdata (L, index));
+        ClassRecord const* const record = ud->m_class;
+        if (record != 0 &&
+            (canBeConst || !record->isConst) &&
+            record->isDerivedFrom (baseClassKey))
+        {
+          return ud;
+        }
+      }
+    }
+
+    return 0;
+  }
+
+  //--------------------------------------------------------------------------
+  /**
+    Validate and retrieve a Userdata on the stack by walking its metatables.
+
+    We do the type check first so that the error message is informative.
+  */
+  static Userdata* getClassChecked (lua_State* L,
+                                    int index,
+                                    void const* baseClassKey,
+                                    bool canBeConst)
+  {
+
     Userdata* ud = 0;
 
     bool mismatch = false;
@@ -203,7 +299,7 @@ private:
     if (lua_isuserdata (L, index))
     {
       // Make sure it's metatable is ours.
-      lua_getmetatable (L, index);
+      getObjectMetatable (L, index);
       lua_rawgetp (L, -1, getIdentityKey ());
       if (lua_isboolean (L, -1))
       {
@@ -300,7 +396,19 @@ ud __parent (nil)
   }
 
 public:
-  virtual ~Userdata () { }
+  //--------------------------------------------------------------------------
+  /**
+    Set the metatable on top of the Lua stack to this Userdata, which is just
+    below it, and remember the class record of the metatable.
+  */
+  void setMetatable (lua_State* L)
+  {
+    // Stack: userdata (ud), metatable (mt)
+    lua_rawgetp (L, -1, getClassRecordKey ()); // Stack: ud, mt, record
+    m_class = static_cast <ClassRecord const*> (lua_touserdata (L, -1));
+    lua_pop (L, 1); // Stack: ud, mt
+    lua_setmetatable (L, -2); // Stack: ud
+  }
 
   //--------------------------------------------------------------------------
   /**
@@ -318,17 +426,95 @@ public:
   /**
     Get a pointer to the class from the Lua stack.
 
-    If the object is not the class or a subclass, or it violates the
-    const-ness, a Lua error is raised.
+    If the object is not the class or a subclass, it violates the
+    const-ness, or it is a handle to a destroyed object, a Lua error is
+    raised.
   */
   template <class T>
   static inline T* get (lua_State* L, int index, bool canBeConst)
   {
     if (lua_isnil (L, index))
       return 0;
-    else
-      return static_cast <T*> (getClass (L, index,
-        ClassInfo <T>::getClassKey (), canBeConst)->getPointer ());
+
+    void* const p = getClass (L, index,
+      ClassInfo <T>::getClassKey (), canBeConst)->getPointer ();
+    if (p == 0)
+      luaL_argerror (L, index, "the object was destroyed");
+    return static_cast <T*> (p);
+  }
+
+  //--------------------------------------------------------------------------
+  /**
+    Determine if the class object at the index is a handle, whose pointer
+    must be resolved on each access.
+  */
+  static bool isHandle (lua_State* L, int index)
+  {
+    Userdata const* const ud = static_cast <Userdata const*> (lua_touserdata (L, index));
+    return ud->m_class != 0 && ud->m_class->isHandle;
+  }
+
+  //--------------------------------------------------------------------------
+  /**
+    Get the pointer of the class object at the index, already validated.
+    This is 0 for a handle to a destroyed object.
+  */
+  static void* getPointer (lua_State* L, int index)
+  {
+    return static_cast <Userdata*> (lua_touserdata (L, index))->getPointer ();
+  }
+
+  //--------------------------------------------------------------------------
+  /**
+    Determine if the value on the Lua stack is an object of the class or
+    a subclass, respecting the const-ness. No error is raised.
+  */
+  template <class T>
+  static inline bool isInstance (lua_State* L, int index, bool canBeConst)
+  {
+    return findClass (L, index, ClassInfo <T>::getClassKey (), canBeConst) != 0;
+  }
+
+  //--------------------------------------------------------------------------
+  /**
+    Get a pointer to the class from the Lua stack, or 0 if the value is not
+    an object of the class or a subclass, or violates the const-ness.
+  */
+  template <class T>
+  static inline T* find (lua_State* L, int index, bool canBeConst)
+  {
+    Userdata* const ud = findClass (L, index, ClassInfo <T>::getClassKey (), canBeConst);
+    return ud != 0 ? static_cast <T*> (ud->getPointer ()) : 0;
+  }
+};
+
+//----------------------------------------------------------------------------
+/**
+  Interface to a class object owned by a Lua userdata.
+
+  The object is destroyed by the __gc metamethod of the class through the
+  destructor function stored in the userdata.
+*/
+class UserdataOwner : public Userdata
+{
+protected:
+  typedef void (*Destructor) (UserdataOwner*);
+
+  explicit UserdataOwner (Destructor destructor)
+    : m_destructor (destructor)
+  {
+  }
+
+private:
+  Destructor const m_destructor;
+
+public:
+  /**
+    Destroy the userdata and the object it owns.
+  */
+  void destroy ()
+  {
+    m_destructor (this);
   }
 };
 
@@ -340,20 +526,27 @@ public:
   inside the userdata using placement new.
 */
 template <class T>
-class UserdataValue : public Userdata
+class UserdataValue : public UserdataOwner
 {
 private:
   UserdataValue <T> (UserdataValue <T> const&);
   UserdataValue <T> operator= (UserdataValue <T> const&);
 
-  char m_storage [sizeof (T)];
+  /**
+    The storage follows the header, so it is aligned like the header. Over
+    aligned types get room to move the object to a suitable address.
+  */
+  static std::size_t const padding =
+    alignof (T) > alignof (UserdataOwner) ? alignof (T) - 1 : 0;
+
+  char m_storage [sizeof (T) + padding];
 
   inline T* getObject ()
   {
     // If this fails to compile it means you forgot to provide
     // a Container specialization for your container!
     //
-    return reinterpret_cast <T*> (&m_storage [0]);
+    return static_cast <T*> (m_p);
   }
 
 private:
@@ -361,8 +554,12 @@ private:
     Used for placement construction.
   */
   UserdataValue ()
+    : UserdataOwner (&destruct)
   {
-    m_p = getObject ();
+    void* storage = &m_storage [0];
+    std::size_t space = sizeof (m_storage);
+    m_p = std::align (alignof (T), sizeof (T), storage, space);
+    assert (m_p != 0);
   }
 
   ~UserdataValue ()
@@ -370,12 +567,21 @@ private:
     getObject ()->~T ();
   }
 
+  static void destruct (UserdataOwner* ud)
+  {
+    static_cast <UserdataValue <T>*> (ud)->~UserdataValue ();
+  }
+
 public:
   /**
     Push a T via placement new.
 
     The caller is responsible for calling placement new using the
     returned uninitialized storage.
+
+    Trivially destructible objects get the metatable without __gc of the
+    class table, so Lua frees them in the cycle they are collected without
+    running a finalizer.
   */
   static void* place (lua_State* const L)
   {
@@ -386,7 +592,13 @@ public:
     {
       throw std::logic_error ("The class is not registered in LuaBridge");
     }
-    lua_setmetatable (L, -2);
+    if (std::is_trivially_destructible <T>::value)
+    {
+      lua_rawgetp (L, -1, getPointerMetatableKey ()); // Stack: ud, class table, pointer mt
+      assert (lua_istable (L, -1));
+      lua_remove (L, -2); // Stack: ud, pointer mt
+    }
+    ud->setMetatable (L);
     return ud->getPointer ();
   }
 
@@ -396,7 +608,8 @@ public:
   template <class U>
   static inline void push (lua_State* const L, U const& u)
   {
-    new (place (L)) U (u);
+    U* const object = new (place (L)) U (u);
+    reportExternalMemory (L, ExternalMemoryTraits <T>::size (*object));
   }
 };
 
@@ -404,7 +617,9 @@ public:
 /**
   Wraps a pointer to a class object inside a Lua userdata.
 
-  The lifetime of the object is managed by C++.
+  The lifetime of the object is managed by C++. The userdata get the pointer
+  metatable of the class or const table, which has no __gc metamethod, so
+  they are not finalized by Lua.
 */
 class UserdataPtr : public Userdata
 {
@@ -413,19 +628,47 @@ private:
   UserdataPtr operator= (UserdataPtr const&);
 
 private:
-  /** Push non-const pointer to object using metatable key.
+  /** Push pointer to object using metatable key.
+
+      If the metatable has a pointer cache, the userdata already pushed
+      for the object is reused.
   */
   static void push (lua_State* L, void* const p, void const* const key)
   {
     if (p)
     {
-      new (lua_newuserdata (L, sizeof (UserdataPtr))) UserdataPtr (p);
-      lua_rawgetp (L, LUA_REGISTRYINDEX, key);
+      lua_rawgetp (L, LUA_REGISTRYINDEX, key); // Stack: mt
       if (!lua_istable (L, -1))
       {
         throw std::logic_error ("The class is not registered in LuaBridge");
       }
-      lua_setmetatable (L, -2);
+
+      lua_rawgetp (L, -1, getPointerCacheKey ()); // Stack: mt, cache | nil
+      if (lua_istable (L, -1))
+      {
+        lua_rawgetp (L, -1, p); // Stack: mt, cache, ud | nil
+        if (!lua_isnil (L, -1))
+        {
+          lua_replace (L, -3); // Stack: ud, cache
+          lua_pop (L, 1); // Stack: ud
+          return;
+        }
+        lua_pop (L, 1); // Stack: mt, cache
+      }
+
+      UserdataPtr* const ud = new (lua_newuserdata (L, sizeof (UserdataPtr))) UserdataPtr (p);
+      lua_rawgetp (L, -3, getPointerMetatableKey ()); // Stack: mt, cache | nil, ud, pointer mt
+      assert (lua_istable (L, -1));
+      ud->setMetatable (L); // Stack: mt, cache | nil, ud
+
+      if (lua_istable (L, -2))
+      {
+        lua_pushvalue (L, -1); // Stack: mt, cache, ud, ud
+        lua_rawsetp (L, -3, p); // cache [p] = ud. Stack: mt, cache, ud
+      }
+
+      lua_replace (L, -3); // Stack: ud, cache | nil
+      lua_pop (L, 1); // Stack: ud
     }
     else
     {
@@ -437,21 +680,7 @@ private:
   */
   static void push (lua_State* L, void const* const p, void const* const key)
   {
-    if (p)
-    {
-      new (lua_newuserdata (L, sizeof (UserdataPtr)))
-        UserdataPtr (const_cast <void*> (p));
-      lua_rawgetp (L, LUA_REGISTRYINDEX, key);
-      if (!lua_istable (L, -1))
-      {
-        throw std::logic_error ("The class is not registered in LuaBridge");
-      }
-      lua_setmetatable (L, -2);
-    }
-    else
-    {
-      lua_pushnil (L);
-    }
+    push (L, const_cast <void*> (p), key);
   }
 
   explicit UserdataPtr (void* const p)
@@ -487,6 +716,56 @@ public:
   }
 };
 
+//----------------------------------------------------------------------------
+/**
+  Wraps a handle to a class object inside a Lua userdata.
+
+  The lifetime of the object is managed by C++. The userdata points to the
+  handle it holds and has the handle record of the class table, so that
+  getPointer () validates the handle on each access. Like pointers, handles
+  get the pointer metatable and are not finalized by Lua.
+*/
+class UserdataHandle : public Userdata
+{
+private:
+  UserdataHandle (UserdataHandle const&);
+  UserdataHandle operator= (UserdataHandle const&);
+
+  explicit UserdataHandle (HandleBase const& handle)
+    : m_handle (handle)
+  {
+    m_p = &m_handle;
+  }
+
+  HandleBase m_handle;
+
+public:
+  /** Push a handle to an object of the class T, or nil if it is stale.
+  */
+  template <class T>
+  static void push (lua_State* L, HandleBase const& handle)
+  {
+    if (handle.getObject () == 0)
+    {
+      lua_pushnil (L);
+      return;
+    }
+
+    UserdataHandle* const ud =
+      new (lua_newuserdata (L, sizeof (UserdataHandle))) UserdataHandle (handle);
+    lua_rawgetp (L, LUA_REGISTRYINDEX, ClassInfo <T>::getClassKey ()); // Stack: ud, class table
+    if (!lua_istable (L, -1))
+    {
+      throw std::logic_error ("The class is not registered in LuaBridge");
+    }
+    lua_rawgetp (L, -1, getPointerMetatableKey ()); // Stack: ud, class table, pointer mt
+    assert (lua_istable (L, -1));
+    lua_remove (L, -2); // Stack: ud, pointer mt
+    ud->setMetatable (L); // Stack: ud
+    ud->m_class = ud->m_class->getHandleRecord ();
+  }
+};
+
 //============================================================================
 /**
   Wraps a container that references a class object.
@@ -495,7 +774,7 @@ public:
   specialized on C or else a compile error will result.
 */
 template <class C>
-class UserdataShared : public Userdata
+class UserdataShared : public UserdataOwner
 {
 private:
   UserdataShared (UserdataShared <C> const&);
@@ -511,12 +790,19 @@ private:
   {
   }
 
+  static void destruct (UserdataOwner* ud)
+  {
+    static_cast <UserdataShared <C>*> (ud)->~UserdataShared ();
+  }
+
 public:
   /**
     Construct from a container to the class or a derived class.
   */
   template <class U>
-  explicit UserdataShared (U const& u) : m_c (u)
+  explicit UserdataShared (U const& u)
+    : UserdataOwner (&destruct)
+    , m_c (u)
   {
     m_p = const_cast <void*> (reinterpret_cast <void const*> (
         (ContainerTraits <C>::get (m_c))));
@@ -526,7 +812,9 @@ public:
     Construct from a pointer to the class or a derived class.
   */
   template <class U>
-  explicit UserdataShared (U* u) : m_c (u)
+  explicit UserdataShared (U* u)
+    : UserdataOwner (&destruct)
+    , m_c (u)
   {
     m_p = const_cast <void*> (reinterpret_cast <void const*> (
         (ContainerTraits <C>::get (m_c))));
@@ -549,11 +837,12 @@ struct UserdataSharedHelper
   {
     if (ContainerTraits <C>::get (c) != 0)
     {
-      new (lua_newuserdata (L, sizeof (UserdataShared <C>))) UserdataShared <C> (c);
+      UserdataShared <C>* const ud =
+        new (lua_newuserdata (L, sizeof (UserdataShared <C>))) UserdataShared <C> (c);
       lua_rawgetp (L, LUA_REGISTRYINDEX, ClassInfo <T>::getClassKey ());
       // If this goes off it means the class T is unregistered!
       assert (lua_istable (L, -1));
-      lua_setmetatable (L, -2);
+      ud->setMetatable (L);
     }
     else
     {
@@ -565,11 +854,12 @@ struct UserdataSharedHelper
   {
     if (t)
     {
-      new (lua_newuserdata (L, sizeof (UserdataShared <C>))) UserdataShared <C> (t);
+      UserdataShared <C>* const ud =
+        new (lua_newuserdata (L, sizeof (UserdataShared <C>))) UserdataShared <C> (t);
       lua_rawgetp (L, LUA_REGISTRYINDEX, ClassInfo <T>::getClassKey ());
       // If this goes off it means the class T is unregistered!
       assert (lua_istable (L, -1));
-      lua_setmetatable (L, -2);
+      ud->setMetatable (L);
     }
     else
     {
@@ -589,11 +879,12 @@ struct UserdataSharedHelper <C, true>
   {
     if (ContainerTraits <C>::get (c) != 0)
     {
-      new (lua_newuserdata (L, sizeof (UserdataShared <C>))) UserdataShared <C> (c);
+      UserdataShared <C>* const ud =
+        new (lua_newuserdata (L, sizeof (UserdataShared <C>))) UserdataShared <C> (c);
       lua_rawgetp (L, LUA_REGISTRYINDEX, ClassInfo <T>::getConstKey ());
       // If this goes off it means the class T is unregistered!
       assert (lua_istable (L, -1));
-      lua_setmetatable (L, -2);
+      ud->setMetatable (L);
     }
     else
     {
@@ -605,11 +896,12 @@ struct UserdataSharedHelper <C, true>
   {
     if (t)
     {
-      new (lua_newuserdata (L, sizeof (UserdataShared <C>))) UserdataShared <C> (t);
+      UserdataShared <C>* const ud =
+        new (lua_newuserdata (L, sizeof (UserdataShared <C>))) UserdataShared <C> (t);
       lua_rawgetp (L, LUA_REGISTRYINDEX, ClassInfo <T>::getConstKey ());
       // If this goes off it means the class T is unregistered!
       assert (lua_istable (L, -1));
-      lua_setmetatable (L, -2);
+      ud->setMetatable (L);
     }
     else
     {
@@ -643,6 +935,11 @@ struct StackHelper
   {
     return Userdata::get <T> (L, index, true);
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return lua_isnil (L, index) || Userdata::isInstance <T> (L, index, true);
+  }
 };
 
 /**
@@ -664,6 +961,11 @@ struct StackHelper <T, false>
   {
     return *Userdata::get <T> (L, index, true);
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return Userdata::isInstance <T> (L, index, true);
+  }
 };
 
 
@@ -694,6 +996,11 @@ struct RefStackHelper
   {
     return Userdata::get <T> (L, index, true);
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return lua_isnil (L, index) || Userdata::isInstance <T> (L, index, true);
+  }
 };
 
 template <class T>
@@ -714,6 +1021,11 @@ struct RefStackHelper <T, false>
       luaL_error (L, "nil passed to reference");
     return *t;
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return Userdata::isInstance <T> (L, index, true);
+  }
 };
 
 
@@ -743,6 +1055,11 @@ struct UserdataGetter
   {
     return Userdata::get <T> (L, index, false);
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return lua_isnil (L, index) || Userdata::isInstance <T> (L, index, false);
+  }
 };
 
 template <class T>
@@ -754,6 +1071,11 @@ struct UserdataGetter <T, typename Void <T (*) ()>::Type>
   {
     return StackHelper <T, TypeTraits::isContainer <T>::value>::get (L, index);
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return StackHelper <T, TypeTraits::isContainer <T>::value>::isInstance (L, index);
+  }
 };
 
 //==============================================================================
@@ -778,6 +1100,11 @@ struct Stack
   {
     return Getter::get (L, index);
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return Getter::isInstance (L, index);
+  }
 };
 
 
@@ -820,6 +1147,11 @@ struct StackOpSelector <T*, true>
   {
     return Userdata::get <T> (L, index, false);
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return lua_isnil (L, index) || Userdata::isInstance <T> (L, index, false);
+  }
 };
 
 // pointer to const
@@ -837,6 +1169,11 @@ struct StackOpSelector <const T*, true>
   {
     return Userdata::get <T> (L, index, true);
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return lua_isnil (L, index) || Userdata::isInstance <T> (L, index, true);
+  }
 };
 
 // reference
@@ -855,6 +1192,11 @@ struct StackOpSelector <T&, true>
   {
     return Helper::get (L, index);
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return Helper::isInstance (L, index);
+  }
 };
 
 // reference to const
@@ -873,6 +1215,11 @@ struct StackOpSelector <const T&, true>
   {
     return Helper::get (L, index);
   }
+
+  static bool isInstance (lua_State* L, int index)
+  {
+    return Helper::isInstance (L, index);
+  }
 };
 
 } // namespace luabridge
@@ -5,8 +5,11 @@
 
 #include "TestBase.h"
 
+#include "LuaBridge/Vector.h"
+
 #include <exception>
 #include <map>
+#include <vector>
 
 
 struct ClassTests : TestBase
@@ -878,3 +881,998 @@ TEST_F (ClassTests, EnclosedClassProperties)
   runLua ("result = outer.data.data");
   ASSERT_EQ (10, result ().cast <int> ());
 }
+
+namespace {
+
+struct FlattenClassHierarchy
+{
+  FlattenClassHierarchy ()
+  {
+    luabridge::setFlattenClassHierarchy (true);
+  }
+
+  ~FlattenClassHierarchy ()
+  {
+    luabridge::setFlattenClassHierarchy (false);
+  }
+};
+
+bool hasRawMember (lua_State* L, void const* tableKey, char const* name)
+{
+  lua_pushlightuserdata (L, const_cast <void*> (tableKey));
+  lua_rawget (L, LUA_REGISTRYINDEX);
+  lua_pushstring (L, name);
+  lua_rawget (L, -2);
+  bool const hasMember = !lua_isnil (L, -1);
+  lua_pop (L, 2);
+  return hasMember;
+}
+
+} // namespace
+
+TEST_F (ClassTests, FlattenedClassHierarchy)
+{
+  using Base = Class <int>;
+  using Middle = Class <int, Base>;
+  using Derived = Class <int, Middle>;
+
+  FlattenClassHierarchy flatten;
+
+  luabridge::getGlobalNamespace (L)
+    .beginClass <Base> ("Base")
+    .addConstructor <void (*) (int)> ()
+    .addFunction ("method", &Base::method)
+    .addFunction ("constMethod", &Base::constMethod)
+    .addProperty ("data", &Base::getData, &Base::setData)
+    .addStaticFunction ("staticFunction", &Base::staticFunction)
+    .endClass ()
+    .deriveClass <Middle, Base> ("Middle")
+    .endClass ()
+    .deriveClass <Derived, Middle> ("Derived")
+    .addConstructor <void (*) (int)> ()
+    .endClass ();
+
+  ASSERT_TRUE (hasRawMember (L, luabridge::ClassInfo <Derived>::getClassKey (), "method"));
+  ASSERT_TRUE (hasRawMember (L, luabridge::ClassInfo <Derived>::getConstKey (), "constMethod"));
+  ASSERT_FALSE (hasRawMember (L, luabridge::ClassInfo <Derived>::getConstKey (), "method"));
+  ASSERT_TRUE (hasRawMember (L, luabridge::ClassInfo <Derived>::getStaticKey (), "staticFunction"));
+
+  Derived derived (1);
+  derived.Base::data = 2;
+  luabridge::setGlobal (L, &derived, "derived");
+
+  runLua ("result = derived:method (3)");
+  ASSERT_EQ (3, result ().cast <int> ());
+
+  runLua ("result = derived:constMethod (4)");
+  ASSERT_EQ (4, result ().cast <int> ());
+
+  runLua ("result = derived.data");
+  ASSERT_EQ (2, result ().cast <int> ());
+
+  runLua ("derived.data = 5");
+  ASSERT_EQ (5, derived.Base::data);
+  ASSERT_EQ (1, derived.data);
+
+  runLua ("result = Derived.staticFunction (Base (6))");
+  ASSERT_EQ (6, result ().cast <Base> ().data);
+}
+
+TEST_F (ClassTests, FlattenedClassHierarchyReopenedBase)
+{
+  using Base = Class <int>;
+  using Derived = Class <int, Base>;
+
+  FlattenClassHierarchy flatten;
+
+  luabridge::getGlobalNamespace (L)
+    .beginClass <Base> ("Base")
+    .addFunction ("method", &Base::method)
+    .endClass ()
+    .deriveClass <Derived, Base> ("Derived")
+    .endClass ();
+
+  Derived derived (1);
+  derived.Base::data = 7;
+  luabridge::setGlobal (L, &derived, "derived");
+
+  runLua ("result = derived:method (2)");
+  ASSERT_EQ (2, result ().cast <int> ());
+
+  luabridge::getGlobalNamespace (L)
+    .beginClass <Base> ("Base")
+    .addFunction ("method", &Base::len)
+    .addFunction ("constMethod", &Base::constMethod)
+    .endClass ();
+
+  runLua ("result = derived:method ()");
+  ASSERT_EQ (7, result ().cast <int> ());
+
+  runLua ("result = derived:constMethod (3)");
+  ASSERT_EQ (3, result ().cast <int> ());
+}
+
+namespace {
+
+void pushPropgetTable (lua_State* L, void const* tableKey)
+{
+  lua_pushlightuserdata (L, const_cast <void*> (tableKey));
+  lua_rawget (L, LUA_REGISTRYINDEX);
+  lua_pushlightuserdata (L, luabridge::getPropgetKey ());
+  lua_rawget (L, -2);
+  lua_remove (L, -2);
+}
+
+} // namespace
+
+TEST_F (ClassTests, PropgetTableIsSharedByConstAndClassTables)
+{
+  using Base = Class <int>;
+  using Derived = Class <int, Base>;
+
+  FlattenClassHierarchy flatten;
+
+  luabridge::getGlobalNamespace (L)
+    .beginClass <Base> ("Base")
+    .addProperty ("data", &Base::getData, &Base::setData)
+    .endClass ()
+    .deriveClass <Derived, Base> ("Derived")
+    .endClass ();
+
+  pushPropgetTable (L, luabridge::ClassInfo <Derived>::getConstKey ());
+  pushPropgetTable (L, luabridge::ClassInfo <Derived>::getClassKey ());
+  ASSERT_TRUE (lua_rawequal (L, -1, -2));
+  lua_pop (L, 2);
+
+  Derived derived (1);
+  derived.Base::data = 2;
+  luabridge::setGlobal (L, &derived, "derived");
+  luabridge::setGlobal (L, static_cast <Derived const*> (&derived), "constDerived");
+
+  runLua ("result = constDerived.data");
+  ASSERT_EQ (2, result ().cast <int> ());
+
+  runLua ("derived.data = 3");
+  ASSERT_EQ (3, derived.Base::data);
+
+  ASSERT_THROW (runLua ("constDerived.data = 4"), std::runtime_error);
+}
+
+namespace {
+
+bool hasMethodTableIndex (lua_State* L, void const* tableKey)
+{
+  lua_pushlightuserdata (L, const_cast <void*> (tableKey));
+  lua_rawget (L, LUA_REGISTRYINDEX);
+  lua_pushstring (L, "__index");
+  lua_rawget (L, -2);
+  bool const isMethodTable = lua_rawequal (L, -1, -2) != 0;
+  lua_pop (L, 2);
+  return isMethodTable;
+}
+
+} // namespace
+
+TEST_F (ClassTests, MethodTableIndex)
+{
+  using Base = Class <int>;
+  using Derived = Class <int, Base>;
+
+  luabridge::getGlobalNamespace (L)
+    .beginClass <Base> ("Base")
+    .addFunction ("method", &Base::method)
+    .addFunction ("constMethod", &Base::constMethod)
+    .endClass ()
+    .deriveClass <Derived, Base> ("Derived")
+    .addFunction ("negate", &Derived::negate)
+    .endClass ();
+
+  ASSERT_TRUE (hasMethodTableIndex (L, luabridge::ClassInfo <Base>::getClassKey ()));
+  ASSERT_TRUE (hasMethodTableIndex (L, luabridge::ClassInfo <Derived>::getClassKey ()));
+  ASSERT_TRUE (hasMethodTableIndex (L, luabridge::ClassInfo <Derived>::getConstKey ()));
+
+  Derived derived (1);
+  luabridge::setGlobal (L, &derived, "derived");
+  luabridge::setGlobal (L, static_cast <Derived const*> (&derived), "constDerived");
+
+  runLua ("result = derived:method (2)");
+  ASSERT_EQ (2, result ().cast <int> ());
+
+  runLua ("result = constDerived:constMethod (3)");
+  ASSERT_EQ (3, result ().cast <int> ());
+
+  runLua ("result = derived:negate ()");
+  ASSERT_EQ (-1, result ().cast <Derived> ().data);
+
+  runLua ("result = constDerived.method");
+  ASSERT_TRUE (result ().isNil ());
+
+  runLua ("result = derived.unknown");
+  ASSERT_TRUE (result ().isNil ());
+
+  ASSERT_THROW (runLua ("constDerived:method (4)"), std::exception);
+}
+
+TEST_F (ClassTests, MethodTableIndexWithProperties)
+{
+  using Base = Class <int>;
+  using Derived = Class <int, Base>;
+
+  luabridge::getGlobalNamespace (L)
+    .beginClass <Base> ("Base")
+    .addFunction ("method", &Base::method)
+    .endClass ()
+    .deriveClass <Derived, Base> ("Derived")
+    .endClass ();
+
+  ASSERT_TRUE (hasMethodTableIndex (L, luabridge::ClassInfo <Derived>::getClassKey ()));
+
+  luabridge::getGlobalNamespace (L)
+    .beginClass <Base> ("Base")
+    .addProperty ("data", &Base::getData, &Base::setData)
+    .endClass ();
+
+  ASSERT_FALSE (hasMethodTableIndex (L, luabridge::ClassInfo <Base>::getClassKey ()));
+  ASSERT_FALSE (hasMethodTableIndex (L, luabridge::ClassInfo <Derived>::getClassKey ()));
+
+  Derived derived (1);
+  derived.Base::data = 5;
+  luabridge::setGlobal (L, &derived, "derived");
+
+  runLua ("result = derived:method (2)");
+  ASSERT_EQ (2, result ().cast <int> ());
+
+  runLua ("result = derived.data");
+  ASSERT_EQ (5, result ().cast <int> ());
+}
+
+namespace {
+
+int getBaseData (Class <int> const* object)
+{
+  return object->data;
+}
+
+void setBaseData (Class <int>* object, Class <int> value)
+{
+  object->data = value.data;
+}
+
+} // namespace
+
+TEST_F (ClassTests, DerivedObjectArguments)
+{
+  using Base = Class <int>;
+  using Middle = Class <int, Base>;
+  using Derived = Class <int, Middle>;
+  using Other = Class <std::string>;
+
+  luabridge::getGlobalNamespace (L)
+    .beginClass <Base> ("Base")
+    .addConstructor <void (*) (int)> ()
+    .endClass ()
+    .deriveClass <Middle, Base> ("Middle")
+    .endClass ()
+    .deriveClass <Derived, Middle> ("Derived")
+    .addConstructor <void (*) (int)> ()
+    .endClass ()
+    .beginClass <Other> ("Other")
+    .addConstructor <void (*) (std::string)> ()
+    .endClass ()
+    .addFunction ("getBaseData", &getBaseData)
+    .addFunction ("setBaseData", &setBaseData);
+
+  Derived derived (1);
+  derived.Base::data = 2;
+  luabridge::setGlobal (L, &derived, "derived");
+  luabridge::setGlobal (L, static_cast <Derived const*> (&derived), "constDerived");
+
+  runLua ("result = getBaseData (derived)");
+  ASSERT_EQ (2, result ().cast <int> ());
+
+  runLua ("result = getBaseData (constDerived)");
+  ASSERT_EQ (2, result ().cast <int> ());
+
+  runLua ("setBaseData (derived, Base (3))");
+  ASSERT_EQ (3, derived.Base::data);
+  ASSERT_EQ (1, derived.data);
+
+  ASSERT_THROW (runLua ("setBaseData (constDerived, Base (4))"), std::exception);
+  ASSERT_THROW (runLua ("getBaseData (Other ('abc'))"), std::exception);
+  ASSERT_THROW (runLua ("getBaseData (io.stdout)"), std::exception);
+  ASSERT_THROW (runLua ("getBaseData ({})"), std::exception);
+  ASSERT_EQ (3, derived.Base::data);
+}
+
+namespace {
+
+struct Copyable
+{
+  Copyable ()
+    : copies (0)
+  {
+  }
+
+  Copyable (Copyable const& other)
+    : copies (other.copies + 1)
+  {
+  }
+
+  int copies;
+};
+
+int getCopies (Copyable const& object, std::string const& name)
+{
+  return name == "copies" ? object.copies : -1;
+}
+
+struct Sum
+{
+  Sum (int a1, int a2, int a3, int a4, int a5,
+       int a6, int a7, int a8, int a9)
+    : value (a1 + a2 + a3 + a4 + a5 + a6 + a7 + a8 + a9)
+  {
+  }
+
+  int add (int a1, int a2, int a3, int a4, int a5,
+           int a6, int a7, int a8, int a9, int a10) const
+  {
+    return value + a1 + a2 + a3 + a4 + a5 + a6 + a7 + a8 + a9 + a10;
+  }
+
+  int value;
+};
+
+} // namespace
+
+TEST_F (ClassTests, ReferenceArgumentsAreNotCopied)
+{
+  luabridge::getGlobalNamespace (L)
+    .beginClass <Copyable> ("Copyable")
+    .addConstructor <void (*) ()> ()
+    .endClass ()
+    .addFunction ("getCopies", &getCopies);
+
+  runLua ("result = getCopies (Copyable (), 'copies')");
+  ASSERT_EQ (0, result ().cast <int> ());
+}
+
+TEST_F (ClassTests, ManyParameters)
+{
+  luabridge::getGlobalNamespace (L)
+    .beginClass <Sum> ("Sum")
+    .addConstructor <void (*) (int, int, int, int, int, int, int, int, int)> ()
+    .addFunction ("add", &Sum::add)
+    .endClass ();
+
+  runLua ("result = Sum (1, 2, 3, 4, 5, 6, 7, 8, 9)"
+          ":add (10, 20, 30, 40, 50, 60, 70, 80, 90, 100)");
+  ASSERT_EQ (595, result ().cast <int> ());
+}
+
+namespace {
+
+struct Overloaded
+{
+  std::string get () const
+  {
+    return "const";
+  }
+
+  std::string get (int value)
+  {
+    return "int " + std::to_string (value);
+  }
+
+  std::string get (Overloaded const&)
+  {
+    return "object";
+  }
+
+  static std::string make (int)
+  {
+    return "static int";
+  }
+
+  static std::string make (Overloaded*)
+  {
+    return "static object";
+  }
+};
+
+} // namespace
+
+TEST_F (ClassTests, OverloadedFunctions)
+{
+  typedef std::string (Overloaded::*ConstGet) () const;
+  typedef std::string (Overloaded::*IntGet) (int);
+  typedef std::string (Overloaded::*ObjectGet) (Overloaded const&);
+  typedef std::string (*IntMake) (int);
+  typedef std::string (*ObjectMake) (Overloaded*);
+
+  luabridge::getGlobalNamespace (L)
+    .beginClass <Overloaded> ("Overloaded")
+    .addConstructor <void (*) ()> ()
+    .addFunction ("get",
+                  static_cast <ConstGet> (&Overloaded::get),
+                  static_cast <IntGet> (&Overloaded::get),
+                  static_cast <ObjectGet> (&Overloaded::get))
+    .addStaticFunction ("make",
+                        static_cast <IntMake> (&Overloaded::make),
+                        static_cast <ObjectMake> (&Overloaded::make))
+    .endClass ();
+
+  Overloaded constObject;
+  luabridge::setGlobal (L, static_cast <Overloaded const*> (&constObject), "constObject");
+  runLua ("object = Overloaded ()");
+
+  runLua ("result = object:get ()");
+  ASSERT_EQ ("const", result ().cast <std::string> ());
+
+  runLua ("result = object:get (1)");
+  ASSERT_EQ ("int 1", result ().cast <std::string> ());
+
+  runLua ("result = object:get (object)");
+  ASSERT_EQ ("object", result ().cast <std::string> ());
+
+  runLua ("result = constObject:get ()");
+  ASSERT_EQ ("const", result ().cast <std::string> ());
+
+  ASSERT_THROW (runLua ("constObject:get (1)"), std::runtime_error);
+  ASSERT_THROW (runLua ("object:get ('a')"), std::runtime_error);
+
+  runLua ("result = Overloaded.make (1)");
+  ASSERT_EQ ("static int", result ().cast <std::string> ());
+
+  runLua ("result = Overloaded.make (object)");
+  ASSERT_EQ ("static object", result ().cast <std::string> ());
+
+  runLua ("result = Overloaded.make (nil)");
+  ASSERT_EQ ("static object", result ().cast <std::string> ());
+}
+
+TEST_F (ClassTests, MethodsReplacedByOverloads)
+{
+  typedef std::string (Overloaded::*ConstGet) () const;
+  typedef std::string (Overloaded::*IntGet) (int);
+  typedef std::string (Overloaded::*ObjectGet) (Overloaded const&);
+
+  luabridge::getGlobalNamespace (L)
+    .beginClass <Overloaded> ("Overloaded")
+    .addConstructor <void (*) ()> ()
+    .addFunction ("get", static_cast <ConstGet> (&Overloaded::get))
+    .endClass ()
+    .addCFunction ("bind", &luabridge::bindMethod)
+    .addCFunction ("each", &luabridge::callEach);
+
+  Overloaded constObject;
+  luabridge::setGlobal (L, static_cast <Overloaded const*> (&constObject), "constObject");
+  runLua ("object = Overloaded () result = bind (object, 'get') ()");
+  ASSERT_EQ ("const", result ().cast <std::string> ());
+  runLua ("each ({object, constObject}, 'get')");
+
+  luabridge::getGlobalNamespace (L)
+    .beginClass <Overloaded> ("Overloaded")
+    .addFunction ("get",
+                  static_cast <IntGet> (&Overloaded::get),
+                  static_cast <ObjectGet> (&Overloaded::get))
+    .endClass ();
+
+  runLua ("result = object:get (1)");
+  ASSERT_EQ ("int 1", result ().cast <std::string> ());
+
+  ASSERT_THROW (runLua ("bind (object, 'get')"), std::runtime_error);
+  ASSERT_THROW (runLua ("each ({object}, 'get', 1)"), std::runtime_error);
+  ASSERT_THROW (runLua ("constObject:get ()"), std::runtime_error);
+  ASSERT_THROW (runLua ("each ({constObject}, 'get')"), std::runtime_error);
+
+  std::vector <Overloaded*> objects (1, &constObject);
+  ASSERT_THROW (
+    luabridge::callEach (L, objects.begin (), objects.end (), "get", 1),
+    luabridge::LuaException);
+}
+
+TEST_F (ClassTests, BoundMethods)
+{
+  using Base = Class <int>;
+  using Derived = Class <int, Base>;
+
+  luabridge::getGlobalNamespace (L)
+    .beginClass <Base> ("Base")
+    .addConstructor <void (*) (int)> ()
+    .addFunction ("method", &Base::method)
+    .addFunction ("constMethod", &Base::constMethod)
+    .endClass ()
+    .deriveClass <Derived, Base> ("Derived")
+    .addConstructor <void (*) (int)> ()
+    .endClass ()
+    .addCFunction ("bind", &luabridge::bindMethod);
+
+  Derived derived (1);
+  luabridge::setGlobal (L, &derived, "derived");
+  luabridge::setGlobal (L, static_cast <Derived const*> (&derived), "constDerived");
+
+  runLua ("local method = bind (derived, 'method') result = method (5)");
+  ASSERT_EQ (5, result ().cast <int> ());
+
+  runLua ("local constMethod = bind (constDerived, 'constMethod') result = constMethod (6)");
+  ASSERT_EQ (6, result ().cast <int> ());
+
+  runLua ("result = bind (derived, 'constMethod') (8)");
+  ASSERT_EQ (8, result ().cast <int> ());
+
+  ASSERT_THROW (runLua ("bind (constDerived, 'method')"), std::runtime_error);
+  ASSERT_THROW (runLua ("bind (derived, 'missing')"), std::runtime_error);
+  ASSERT_THROW (runLua ("bind ({}, 'method')"), std::runtime_error);
+
+  luabridge::LuaRef const method = luabridge::bindMethod (
+    luabridge::LuaRef (L, &derived), "method");
+  ASSERT_EQ (7, method (7).cast <int> ());
+
+  ASSERT_THROW (
+    luabridge::bindMethod (luabridge::LuaRef (L, &derived), "missing"),
+    luabridge::LuaException);
+}
+
+namespace {
+
+struct Counter
+{
+  void add (int value)
+  {
+    total += value;
+  }
+
+  void append (std::string value)
+  {
+    text += value;
+  }
+
+  int total = 0;
+  std::string text;
+};
+
+struct DerivedCounter : Counter
+{
+};
+
+} // namespace
+
+TEST_F (ClassTests, CallEach)
+{
+  luabridge::getGlobalNamespace (L)
+    .beginClass <Counter> ("Counter")
+    .addConstructor <void (*) ()> ()
+    .addFunction ("add", &Counter::add)
+    .addFunction ("append", &Counter::append)
+    .endClass ()
+    .deriveClass <DerivedCounter, Counter> ("DerivedCounter")
+    .addConstructor <void (*) ()> ()
+    .endClass ()
+    .addCFunction ("each", &luabridge::callEach);
+
+  Counter first;
+  DerivedCounter second;
+  luabridge::setGlobal (L, &first, "first");
+  luabridge::setGlobal (L, &second, "second");
+
+  runLua ("each ({first, second}, 'add', 2) each ({first, second}, 'append', 'ab')");
+  ASSERT_EQ (2, first.total);
+  ASSERT_EQ (2, second.total);
+  ASSERT_EQ ("ab", first.text);
+  ASSERT_EQ ("ab", second.text);
+
+  runLua ("each ({}, 'missing')");
+
+  ASSERT_THROW (runLua ("each ({first, second}, 'missing')"), std::runtime_error);
+  ASSERT_THROW (runLua ("each ({first, second}, 'add', 'x')"), std::runtime_error);
+  ASSERT_THROW (runLua ("each ({first, 1}, 'add', 1)"), std::runtime_error);
+  ASSERT_EQ (3, first.total); // Objects before the bad element are called
+
+  std::vector <Counter*> counters;
+  counters.push_back (&first);
+  counters.push_back (&second);
+  luabridge::callEach (luabridge::LuaRef (L, counters), "add", 3);
+  ASSERT_EQ (6, first.total);
+  ASSERT_EQ (5, second.total);
+
+  ASSERT_THROW (
+    luabridge::callEach (luabridge::LuaRef (L, counters), "missing"),
+    luabridge::LuaException);
+
+  int const top = lua_gettop (L);
+  luabridge::callEach (L, counters.begin (), counters.end (), "add", 4);
+  ASSERT_EQ (10, first.total);
+  ASSERT_EQ (9, second.total);
+
+  std::vector <Counter> values (2);
+  luabridge::callEach (L, values.begin (), values.end (), "append", std::string ("cd"));
+  ASSERT_EQ ("cd", values [0].text);
+  ASSERT_EQ ("cd", values [1].text);
+  ASSERT_EQ (top, lua_gettop (L));
+
+  std::vector <Counter const*> constCounters (counters.begin (), counters.end ());
+  ASSERT_THROW (
+    luabridge::callEach (L, constCounters.begin (), constCounters.end (), "add", 1),
+    luabridge::LuaException);
+
+  counters.push_back (0);
+  ASSERT_THROW (
+    luabridge::callEach (L, counters.begin (), counters.end (), "add", 1),
+    luabridge::LuaException);
+  ASSERT_EQ (11, first.total); // Objects before the null pointer are called
+}
+
+TEST_F (ClassTests, PointerCache)
+{
+  using Cached = Class <int>;
+  using Uncached = Class <int, Cached>;
+
+  luabridge::getGlobalNamespace (L)
+    .beginClass <Cached> ("Cached")
+    .cachePointers ()
+    .endClass ()
+    .deriveClass <Uncached, Cached> ("Uncached")
+    .endClass ();
+
+  Cached cached;
+  luabridge::setGlobal (L, &cached, "first");
+  luabridge::setGlobal (L, &cached, "second");
+  luabridge::setGlobal (L, static_cast <Cached const*> (&cached), "constFirst");
+  luabridge::Stack <Cached const&>::push (L, cached);
+  lua_setglobal (L, "constSecond");
+
+  runLua ("result = rawequal (first, second)");
+  ASSERT_TRUE (result ().cast <bool> ());
+
+  runLua ("result = rawequal (constFirst, constSecond)");
+  ASSERT_TRUE (result ().cast <bool> ());
+
+  runLua ("result = rawequal (first, constFirst)");
+  ASSERT_FALSE (result ().cast <bool> ());
+
+  runLua ("first, second = nil, nil collectgarbage ()");
+  luabridge::setGlobal (L, &cached, "first");
+  runLua ("result = first");
+  ASSERT_EQ (&cached, result ().cast <Cached*> ());
+
+  Uncached uncached;
+  luabridge::setGlobal (L, &uncached, "first");
+  luabridge::setGlobal (L, &uncached, "second");
+
+  runLua ("result = rawequal (first, second)");
+  ASSERT_FALSE (result ().cast <bool> ());
+}
+
+TEST_F (ClassTests, ObjectFields)
+{
+  typedef Class <int> Base;
+  typedef Class <float, Base> Derived;
+  typedef Class <std::string> Other;
+
+  luabridge::getGlobalNamespace (L)
+    .beginClass <Base> ("Base")
+    .addConstructor <void (*) (int)> ()
+    .addData ("data", &Base::data)
+    .addFunction ("method", &Base::method)
+    .addObjectFields ()
+    .endClass ()
+    .deriveClass <Derived, Base> ("Derived")
+    .addConstructor <void (*) (float)> ()
+    .endClass ()
+    .beginClass <Other> ("Other")
+    .addConstructor <void (*) (std::string)> ()
+    .endClass ();
+
+  runLua ("object = Base (1) result = object.name");
+  ASSERT_TRUE (result ().isNil ());
+
+  runLua ("object.name = 'first' object [1] = 2 result = object.name .. object [1]");
+  ASSERT_EQ ("first2", result ().cast <std::string> ());
+
+  runLua ("object.data = 3 result = object.data + object:method (4)");
+  ASSERT_EQ (7, result ().cast <int> ());
+  ASSERT_EQ (3, variable <Base const*> ("object")->data);
+
+  runLua ("result = Base (5).name");
+  ASSERT_TRUE (result ().isNil ());
+
+  runLua ("derived = Derived (1.5) derived.name = 'second' result = derived.name");
+  ASSERT_EQ ("second", result ().cast <std::string> ());
+
+  Base const constObject (6);
+  luabridge::setGlobal (L, &constObject, "constObject");
+  runLua ("result = constObject.name");
+  ASSERT_TRUE (result ().isNil ());
+  ASSERT_THROW (runLua ("constObject.name = 'third'"), std::runtime_error);
+
+  ASSERT_THROW (runLua ("other = Other ('a') other.name = 'fourth'"), std::runtime_error);
+}
+
+TEST_F (ClassTests, PointerCacheAndObjectFieldsAreExclusive)
+{
+  typedef Class <int> Base;
+  typedef Class <float, Base> Derived;
+  typedef Class <std::string> Other;
+
+  luabridge::getGlobalNamespace (L)
+    .beginClass <Base> ("Base")
+    .endClass ()
+    .deriveClass <Derived, Base> ("Derived")
+    .cachePointers ()
+    .endClass ()
+    .beginClass <Other> ("Other")
+    .addObjectFields ()
+    .endClass ();
+
+  ASSERT_THROW (
+    luabridge::getGlobalNamespace (L)
+      .beginClass <Base> ("Base")
+      .addObjectFields (),
+    std::logic_error);
+
+  ASSERT_THROW (
+    luabridge::getGlobalNamespace (L)
+      .beginClass <Derived> ("Derived")
+      .addObjectFields (),
+    std::logic_error);
+
+  ASSERT_THROW (
+    luabridge::getGlobalNamespace (L)
+      .beginClass <Other> ("Other")
+      .cachePointers (),
+    std::logic_error);
+}
+
+TEST_F (ClassTests, PointersAreNotFinalized)
+{
+  typedef Class <int> Int;
+
+  luabridge::getGlobalNamespace (L)
+    .beginClass <Int> ("Int")
+    .addConstructor <void (*) (int)> ()
+    .addData ("data", &Int::data)
+    .endClass ();
+
+  Int object (5);
+  luabridge::setGlobal (L, &object, "pointer");
+
+  lua_getglobal (L, "pointer");
+  ASSERT_TRUE (lua_getmetatable (L, -1));
+  lua_getfield (L, -1, "__gc");
+  ASSERT_TRUE (lua_isnil (L, -1));
+  lua_pop (L, 3);
+
+  ASSERT_EQ (2 * sizeof (void*), sizeof (luabridge::UserdataPtr));
+
+  // Metamethods added when the class is reopened are seen by pointers
+  luabridge::getGlobalNamespace (L)
+    .beginClass <Int> ("Int")
+    .addFunction ("__tostring", &Int::toString)
+    .endClass ();
+
+  runLua ("pointer.data = 6 result = tostring (pointer)");
+  ASSERT_EQ ("6", result ().cast <std::string> ());
+  ASSERT_EQ (6, object.data);
+}
+
+namespace {
+
+struct Counted
+{
+  explicit Counted (int& destructions)
+    : destructions (destructions)
+  {
+  }
+
+  ~Counted ()
+  {
+    ++destructions;
+  }
+
+  int& destructions;
+};
+
+} // namespace
+
+TEST_F (ClassTests, TriviallyDestructibleValuesAreNotFinalized)
+{
+  typedef Class <int> Int;
+
+  luabridge::getGlobalNamespace (L)
+    .beginClass <Int> ("Int")
+    .addConstructor <void (*) (int)> ()
+    .addFunction ("__tostring", &Int::toString)
+    .endClass ()
+    .beginClass <Counted> ("Counted")
+    .endClass ();
+
+  int destructions = 0;
+  luabridge::push (L, Counted (destructions));
+  lua_setglobal (L, "counted");
+  destructions = 0;
+
+  runLua ("value = Int (7)");
+
+  lua_getglobal (L, "value");
+  ASSERT_TRUE (lua_getmetatable (L, -1));
+  lua_getfield (L, -1, "__gc");
+  ASSERT_TRUE (lua_isnil (L, -1));
+  lua_pop (L, 3);
+
+  lua_getglobal (L, "counted");
+  ASSERT_TRUE (lua_getmetatable (L, -1));
+  lua_getfield (L, -1, "__gc");
+  ASSERT_TRUE (lua_iscfunction (L, -1));
+  lua_pop (L, 3);
+
+  runLua ("result = tostring (value)");
+  ASSERT_EQ ("7", result ().cast <std::string> ());
+
+  runLua ("value, counted = nil, nil collectgarbage ()");
+  ASSERT_EQ (1, destructions);
+}
+
+namespace {
+
+struct Buffer
+{
+  explicit Buffer (int& destructions)
+    : bytes (1024 * 1024)
+    , destructions (destructions)
+  {
+  }
+
+  ~Buffer ()
+  {
+    ++destructions;
+  }
+
+  std::vector <char> bytes;
+  int& destructions;
+};
+
+} // namespace
+
+namespace luabridge {
+
+template <>
+struct ExternalMemoryTraits <Buffer>
+{
+  static std::size_t size (Buffer const& buffer)
+  {
+    return buffer.bytes.capacity ();
+  }
+};
+
+} // namespace luabridge
+
+TEST_F (ClassTests, ExternalMemory)
+{
+  luabridge::getGlobalNamespace (L)
+    .beginClass <Buffer> ("Buffer")
+    .endClass ();
+
+  int destructions = 0;
+  for (int i = 0; i < 100; ++i)
+  {
+    luabridge::push (L, Buffer (destructions));
+    lua_pop (L, 1);
+  }
+
+  // 100 copies and at least part of the 100 userdata
+  ASSERT_GT (destructions, 150);
+
+  lua_gc (L, LUA_GCCOLLECT, 0);
+  ASSERT_EQ (200, destructions);
+
+#if LUA_VERSION_NUM >= 502
+  // A stopped collector stays stopped.
+  destructions = 0;
+  lua_gc (L, LUA_GCSTOP, 0);
+  for (int i = 0; i < 100; ++i)
+  {
+    luabridge::push (L, Buffer (destructions));
+    lua_pop (L, 1);
+  }
+  ASSERT_EQ (100, destructions);
+  ASSERT_EQ (0, lua_gc (L, LUA_GCISRUNNING, 0));
+
+  lua_gc (L, LUA_GCRESTART, 0);
+  lua_gc (L, LUA_GCCOLLECT, 0);
+  ASSERT_EQ (200, destructions);
+#endif
+}
+
+namespace {
+
+struct alignas (32) AlignedVector
+{
+  AlignedVector ()
+    : x (), y (), z (), w ()
+  {
+  }
+
+  bool isAligned () const
+  {
+    return reinterpret_cast <std::uintptr_t> (this) % alignof (AlignedVector) == 0;
+  }
+
+  float x, y, z, w;
+};
+
+} // namespace
+
+TEST_F (ClassTests, OverAlignedValues)
+{
+  luabridge::getGlobalNamespace (L)
+    .beginClass <AlignedVector> ("AlignedVector")
+    .addConstructor <void (*) ()> ()
+    .addFunction ("isAligned", &AlignedVector::isAligned)
+    .endClass ();
+
+  runLua (
+    "result = true "
+    "for i = 1, 100 do "
+    "  local v = AlignedVector () "
+    "  result = result and v:isAligned () "
+    "end");
+  ASSERT_TRUE (result ().cast <bool> ());
+
+  for (int i = 0; i < 100; ++i)
+  {
+    luabridge::push (L, AlignedVector ());
+    ASSERT_TRUE (luabridge::Stack <AlignedVector const&>::get (L, -1).isAligned ());
+    lua_pop (L, 1);
+  }
+}
+
+#ifdef LUABRIDGE_CXX17
+
+TEST_F (ClassTests, InlineFunctions)
+{
+  using Int = Class <int>;
+
+  luabridge::getGlobalNamespace (L)
+    .beginClass <Int> ("Int")
+    .addConstructor <void (*) (int)> ()
+    .addFunction <&Int::method> ("theMethod")
+    .addFunction <&Int::constMethod> ("constMethod")
+    .addFunction <&Int::len> ("len")
+    .addStaticFunction <&Int::staticFunction> ("staticFunction")
+    .endClass ()
+    .addFunction ("returnConstPtr", &returnConstPtr)
+    .addCFunction ("bind", &luabridge::bindMethod)
+    .addCFunction ("each", &luabridge::callEach);
+
+  runLua ("object = Int (501)");
+
+  runLua ("result = object:theMethod (3)");
+  ASSERT_EQ (3, result ().cast <int> ());
+
+  runLua ("result = object:constMethod (5)");
+  ASSERT_EQ (5, result ().cast <int> ());
+
+  runLua ("result = object:len ()");
+  ASSERT_EQ (501, result ().cast <int> ());
+
+  runLua ("result = bind (object, 'theMethod') (4)");
+  ASSERT_EQ (4, result ().cast <int> ());
+
+  runLua ("each ({object, Int (2)}, 'constMethod', 1)");
+  ASSERT_THROW (runLua ("each ({object, 2}, 'theMethod', 1)"), std::runtime_error);
+
+  runLua ("result = Int.staticFunction (Int (7))");
+  ASSERT_EQ (7, result ().cast <Int> ().data);
+
+  runLua ("result = returnConstPtr ().theMethod"); // Don't call, just get
+  ASSERT_TRUE (result ().isNil ());
+
+  ASSERT_THROW (
+    luabridge::getGlobalNamespace (L)
+      .beginClass <Int> ("Int")
+      .addFunction <&Int::method> ("__gc"),
+    std::logic_error);
+}
+
+#endif // LUABRIDGE_CXX17
@@ -0,0 +1,156 @@
+// https://github.com/vinniefalco/LuaBridge
+//
+// Copyright 2019, Dmitry Tarakanov
+// SPDX-License-Identifier: MIT
+
+#include "TestBase.h"
+
+#include "LuaBridge/Handle.h"
+
+#include <memory>
+
+
+struct HandleTests : TestBase
+{
+};
+
+namespace {
+
+struct Widget : luabridge::HandleObject <Widget>
+{
+  explicit Widget (int value)
+    : value (value)
+  {
+  }
+
+  int getValue () const
+  {
+    return value;
+  }
+
+  int value;
+};
+
+struct Button : Widget
+{
+  explicit Button (int value)
+    : Widget (value)
+  {
+  }
+
+  int click ()
+  {
+    return ++value;
+  }
+};
+
+} // namespace
+
+TEST_F (HandleTests, Operators)
+{
+  std::unique_ptr <Widget> widget (new Widget (1));
+  luabridge::Handle <Widget> handle (widget.get ());
+  luabridge::Handle <Widget> empty;
+
+  ASSERT_TRUE (handle.isValid ());
+  ASSERT_EQ (widget.get (), handle.get ());
+  ASSERT_EQ (1, handle->getValue ());
+  ASSERT_FALSE (empty.isValid ());
+  ASSERT_TRUE (handle != empty);
+  ASSERT_TRUE (handle == luabridge::Handle <Widget> (*widget));
+
+  widget.reset ();
+  ASSERT_FALSE (handle.isValid ());
+  ASSERT_EQ (nullptr, handle.get ());
+}
+
+TEST_F (HandleTests, SlotReuseInvalidatesOldHandles)
+{
+  std::unique_ptr <Widget> first (new Widget (1));
+  luabridge::Handle <Widget> firstHandle (first.get ());
+  std::uint32_t const index = first->getHandleIndex ();
+  first.reset ();
+
+  Widget second (2);
+  ASSERT_EQ (index, second.getHandleIndex ());
+  ASSERT_EQ (nullptr, firstHandle.get ());
+  ASSERT_EQ (&second, luabridge::Handle <Widget> (second).get ());
+}
+
+TEST_F (HandleTests, InvalidatedInLua)
+{
+  luabridge::getGlobalNamespace (L)
+    .beginClass <Widget> ("Widget")
+    .addFunction ("getValue", &Widget::getValue)
+    .endClass ();
+
+  std::unique_ptr <Widget> widget (new Widget (5));
+  luabridge::setGlobal (L, luabridge::Handle <Widget> (widget.get ()), "widget");
+
+  runLua ("result = widget:getValue ()");
+  ASSERT_EQ (5, result ().cast <int> ());
+
+  widget.reset ();
+  ASSERT_THROW (runLua ("result = widget:getValue ()"), std::exception);
+
+  luabridge::Handle <Widget> stale;
+  luabridge::setGlobal (L, stale, "widget");
+  runLua ("result = widget");
+  ASSERT_TRUE (result ().isNil ());
+}
+
+TEST_F (HandleTests, DerivedClassesAndParameters)
+{
+  luabridge::getGlobalNamespace (L)
+    .beginClass <Widget> ("Widget")
+    .addFunction ("getValue", &Widget::getValue)
+    .endClass ()
+    .deriveClass <Button, Widget> ("Button")
+    .addFunction ("click", &Button::click)
+    .endClass ();
+
+  std::unique_ptr <Button> button (new Button (1));
+  luabridge::setGlobal (L, luabridge::Handle <Button> (button.get ()), "button");
+
+  runLua ("button:click (); result = button:getValue ()");
+  ASSERT_EQ (2, result ().cast <int> ());
+
+  runLua ("result = button");
+  luabridge::Handle <Widget> handle = result ().cast <luabridge::Handle <Widget> > ();
+  ASSERT_EQ (button.get (), handle.get ());
+  result ().push (L);
+  ASSERT_TRUE (luabridge::Stack <luabridge::Handle <Widget> >::isInstance (L, -1));
+  lua_pop (L, 1);
+
+  button.reset ();
+  ASSERT_FALSE (handle.isValid ());
+  ASSERT_THROW (runLua ("result = button:getValue ()"), std::exception);
+}
+
+TEST_F (HandleTests, BoundMethodsOfDestroyedObjects)
+{
+  luabridge::getGlobalNamespace (L)
+    .beginClass <Widget> ("Widget")
+    .addFunction ("getValue", &Widget::getValue)
+#ifdef LUABRIDGE_CXX17
+    .addFunction <&Widget::getValue> ("getInlineValue")
+#endif
+    .endClass ()
+    .addCFunction ("bind", &luabridge::bindMethod);
+
+  std::unique_ptr <Widget> widget (new Widget (3));
+  luabridge::setGlobal (L, luabridge::Handle <Widget> (widget.get ()), "widget");
+
+  runLua ("getValue = bind (widget, 'getValue') result = getValue ()");
+  ASSERT_EQ (3, result ().cast <int> ());
+#ifdef LUABRIDGE_CXX17
+  runLua ("getInlineValue = bind (widget, 'getInlineValue') result = getInlineValue ()");
+  ASSERT_EQ (3, result ().cast <int> ());
+#endif
+
+  widget.reset ();
+  ASSERT_THROW (runLua ("getValue ()"), std::exception);
+#ifdef LUABRIDGE_CXX17
+  ASSERT_THROW (runLua ("getInlineValue ()"), std::exception);
+#endif
+}
@@ -0,0 +1,139 @@
+// https://github.com/vinniefalco/LuaBridge
+//
+// Copyright 2019, Dmitry Tarakanov
+// SPDX-License-Identifier: MIT
+
+#include "TestBase.h"
+
+#include "LuaBridge/LuaFunction.h"
+
+#include <tuple>
+#include <vector>
+
+
+struct LuaFunctionTests : TestBase
+{
+};
+
+namespace {
+
+std::vector <luabridge::LuaFunction <int (int)> > subscribers;
+
+void subscribe (luabridge::LuaFunction <int (int)> callback)
+{
+  subscribers.push_back (callback);
+}
+
+struct Unregistered
+{
+};
+
+} // namespace
+
+TEST_F (LuaFunctionTests, TypedCalls)
+{
+  runLua ("function concat (s, n) return s .. n end");
+  luabridge::LuaFunction <std::string (std::string const&, int)> concat =
+    luabridge::getGlobal (L, "concat");
+
+  int const top = lua_gettop (L);
+  std::vector <std::string> const refs = getRegistryRefs ();
+  ASSERT_EQ ("a1", concat ("a", 1));
+  ASSERT_EQ ("b2", concat ("b", 2));
+  ASSERT_EQ (refs, getRegistryRefs ());
+  ASSERT_EQ (top, lua_gettop (L));
+
+  runLua ("function store (...) result = select ('#', ...) end");
+  luabridge::LuaFunction <void (int, int, int, int, int, int, int, int, int, int)> store =
+    luabridge::getGlobal (L, "store");
+  store (1, 2, 3, 4, 5, 6, 7, 8, 9, 10);
+  ASSERT_EQ (10, result ().cast <int> ());
+  ASSERT_EQ (top, lua_gettop (L));
+}
+
+TEST_F (LuaFunctionTests, ErrorsHaveATraceback)
+{
+  runLua (
+    "function fail (message) error (message) end "
+    "t = {call = function (message) fail (message) end}");
+  luabridge::LuaFunction <void (std::string)> call =
+    luabridge::getGlobal (L, "t") ["call"];
+
+  int const top = lua_gettop (L);
+  try
+  {
+    call ("failure");
+    FAIL ();
+  }
+  catch (luabridge::LuaException const& e)
+  {
+    std::string const what = e.what ();
+    ASSERT_NE (std::string::npos, what.find ("failure\nstack traceback:"));
+    ASSERT_NE (std::string::npos, what.find ("in function 'fail'"));
+  }
+  ASSERT_EQ (top, lua_gettop (L));
+}
+
+TEST_F (LuaFunctionTests, FailedArgumentsRestoreTheStack)
+{
+  runLua ("function take (n, x) result = n end");
+  luabridge::LuaFunction <void (int, Unregistered)> take =
+    luabridge::getGlobal (L, "take");
+
+  int const top = lua_gettop (L);
+  ASSERT_THROW (take (1, Unregistered ()), std::logic_error);
+  ASSERT_EQ (top, lua_gettop (L));
+  ASSERT_TRUE (result ().isNil ());
+}
+
+TEST_F (LuaFunctionTests, Parameter)
+{
+  luabridge::getGlobalNamespace (L)
+    .addFunction ("subscribe", &subscribe);
+
+  runLua (
+    "subscribe (function (x) return x + 1 end) "
+    "subscribe (function (x) return x * 2 end)");
+
+  ASSERT_EQ (2u, subscribers.size ());
+  ASSERT_EQ (4, subscribers [0] (3));
+  ASSERT_EQ (6, subscribers [1] (3));
+  subscribers.clear ();
+
+  ASSERT_THROW (runLua ("subscribe (1)"), std::exception);
+}
+
+TEST_F (LuaFunctionTests, LuaRefCallsTakeAnyNumberOfArguments)
+{
+  runLua ("function count (...) return select ('#', ...) end");
+  luabridge::LuaRef count = luabridge::getGlobal (L, "count");
+  ASSERT_EQ (0, count ().cast <int> ());
+  ASSERT_EQ (9, count (1, 2, 3, 4, 5, 6, 7, 8, "nine").cast <int> ());
+}
+
+TEST_F (LuaFunctionTests, MultipleResults)
+{
+  runLua ("function divide (a, b) return math.floor (a / b), a % b end");
+  luabridge::LuaFunction <std::tuple <int, int> (int, int)> divide =
+    luabridge::getGlobal (L, "divide");
+
+  int const top = lua_gettop (L);
+  std::vector <std::string> const refs = getRegistryRefs ();
+  ASSERT_EQ (std::make_tuple (3, 1), divide (7, 2));
+  ASSERT_EQ (refs, getRegistryRefs ());
+  ASSERT_EQ (top, lua_gettop (L));
+
+  int quotient = 0;
+  std::string remainder;
+  std::tie (quotient, remainder) =
+    luabridge::getGlobal (L, "divide").call <int, std::string> (9, 4);
+  ASSERT_EQ (2, quotient);
+  ASSERT_EQ ("1", remainder);
+  ASSERT_EQ (top, lua_gettop (L));
+
+  runLua ("function one () return 1 end");
+  auto results = luabridge::getGlobal (L, "one").call <int, luabridge::LuaRef> ();
+  ASSERT_EQ (1, std::get <0> (results));
+  ASSERT_TRUE (std::get <1> (results).isNil ());
+  ASSERT_EQ (top, lua_gettop (L));
+}
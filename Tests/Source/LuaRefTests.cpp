@@ -247,6 +247,185 @@ TEST_F (LuaRefTests, Assignment)
   ASSERT_TRUE (b1 == b2);
 }
 
+namespace {
+
+luabridge::LuaRef makeTable (lua_State* L)
+{
+  luabridge::LuaRef table = luabridge::newTable (L);
+  table ["a"] = 1;
+  return table;
+}
+
+} // namespace
+
+TEST_F (LuaRefTests, MovesDoNotTouchTheRegistry)
+{
+  luabridge::LuaRef table = makeTable (L);
+  std::vector <std::string> const refs = getRegistryRefs ();
+
+  luabridge::LuaRef moved (std::move (table));
+  ASSERT_TRUE (table.isNil ());
+  ASSERT_TRUE (moved.isTable ());
+
+  std::vector <luabridge::LuaRef> vector;
+  vector.push_back (std::move (moved));
+  for (int i = 0; i < 100; ++i)
+  {
+    vector.push_back (luabridge::LuaRef (L));
+  }
+  table = std::move (vector [0]);
+  ASSERT_EQ (refs, getRegistryRefs ());
+
+  vector.clear ();
+  ASSERT_EQ (refs, getRegistryRefs ());
+  ASSERT_EQ (1, table ["a"].cast <int> ());
+
+  auto proxy = table ["a"];
+  std::vector <std::string> const proxyRefs = getRegistryRefs ();
+  auto movedProxy (std::move (proxy));
+  ASSERT_EQ (proxyRefs, getRegistryRefs ());
+  ASSERT_EQ (1, movedProxy.cast <int> ());
+}
+
+TEST_F (LuaRefTests, ProxyAssignmentCopiesTheValue)
+{
+  runLua ("t = {a = 1, b = 2}");
+  luabridge::LuaRef table = luabridge::getGlobal (L, "t");
+
+  table ["a"] = table ["b"];
+  runLua ("result = t.a");
+  ASSERT_EQ (2, result ().cast <int> ());
+
+  auto b = table ["b"];
+  b = 3;
+  auto a = table ["a"];
+  a = b;
+  runLua ("result = t.a");
+  ASSERT_EQ (3, result ().cast <int> ());
+}
+
+TEST_F (LuaRefTests, ProxiesWithStringAndIntegerKeysDoNotTouchTheRegistry)
+{
+  runLua ("t = {a = 1, [2] = 'two'}");
+  luabridge::LuaRef table = luabridge::getGlobal (L, "t");
+  std::vector <std::string> const refs = getRegistryRefs ();
+
+  ASSERT_EQ (1, table ["a"].cast <int> ());
+  ASSERT_EQ ("two", table [2].cast <std::string> ());
+  table ["a"] = 10;
+  table [2].rawset ("deux");
+  table [std::string ("d")] = table ["a"];
+  ASSERT_EQ (refs, getRegistryRefs ());
+
+  runLua ("result = t.a .. t [2] .. t.d");
+  ASSERT_EQ ("10deux10", result ().cast <std::string> ());
+}
+
+TEST_F (LuaRefTests, NestedProxies)
+{
+  runLua ("t = {sub = {b = {c = 3}}}");
+  luabridge::LuaRef table = luabridge::getGlobal (L, "t");
+
+  ASSERT_EQ (3, table ["sub"]["b"]["c"].cast <int> ());
+  table ["sub"]["b"]["c"] = 4;
+  runLua ("result = t.sub.b.c");
+  ASSERT_EQ (4, result ().cast <int> ());
+
+  auto proxy = luabridge::getGlobal (L, "t") ["sub"];
+  auto copy = proxy;
+  auto moved = std::move (copy);
+  lua_gc (L, LUA_GCCOLLECT, 0);
+  ASSERT_TRUE (proxy.isTable ());
+  ASSERT_EQ (4, moved ["b"]["c"].cast <int> ());
+}
+
+TEST_F (LuaRefTests, ProxiesWithOtherKeys)
+{
+  runLua ("key = {} t = {[key] = 'table', [true] = 'yes'}");
+  luabridge::LuaRef table = luabridge::getGlobal (L, "t");
+  luabridge::LuaRef key = luabridge::getGlobal (L, "key");
+
+  ASSERT_EQ ("table", table [key].cast <std::string> ());
+  ASSERT_EQ ("yes", table [true].cast <std::string> ());
+  table [key] = "changed";
+  ASSERT_EQ ("changed", table [key].cast <std::string> ());
+  table [luabridge::getGlobal (L, "key")].rawset ("raw");
+  table ["self"] = key;
+  ASSERT_EQ ("raw", table [table ["self"]].cast <std::string> ());
+
+  runLua ("other = {} t [other] = 1");
+  ASSERT_EQ (1, table [luabridge::getGlobal (L, "other")].cast <int> ());
+
+  key.push (L);
+  luabridge::LuaStackRef stackKey (L, -1);
+  ASSERT_EQ ("raw", table [stackKey].cast <std::string> ());
+  lua_pop (L, 1);
+
+  char const* const nullKey = 0;
+  ASSERT_TRUE (table [nullKey].isNil ());
+  char name [] = "name";
+  table [name] = "array";
+  ASSERT_EQ ("array", table [std::string ("name")].cast <std::string> ());
+}
+
+namespace {
+
+int sumPoint (luabridge::LuaStackRef point)
+{
+  if (!point.isTable ())
+  {
+    return -1;
+  }
+  point ["sum"] = point ["x"].cast <int> () + point [2].cast <int> ();
+  return point ["sum"];
+}
+
+int callTwice (luabridge::LuaStackRef const& function, int value)
+{
+  return function (function (value)).cast <int> ();
+}
+
+} // namespace
+
+TEST_F (LuaRefTests, StackRefParameters)
+{
+  luabridge::getGlobalNamespace (L)
+    .addFunction ("sumPoint", &sumPoint)
+    .addFunction ("callTwice", &callTwice);
+
+  runLua ("point = {x = 1, [2] = 2}");
+  std::vector <std::string> const refs = getRegistryRefs ();
+  runLua ("result = sumPoint (point)");
+  ASSERT_EQ (refs, getRegistryRefs ());
+  ASSERT_EQ (3, result ().cast <int> ());
+  runLua ("result = point.sum");
+  ASSERT_EQ (3, result ().cast <int> ());
+
+  runLua ("result = sumPoint (5)");
+  ASSERT_EQ (-1, result ().cast <int> ());
+
+  runLua ("result = callTwice (function (x) return x * 3 end, 2)");
+  ASSERT_EQ (18, result ().cast <int> ());
+}
+
+TEST_F (LuaRefTests, StackRef)
+{
+  runLua ("result = {a = 'b'}");
+  luabridge::LuaRef table = result ();
+  lua_pushinteger (L, 7);
+  table.push (L);
+
+  luabridge::LuaStackRef view (L, -1);
+  ASSERT_EQ (lua_gettop (L), view.getIndex ());
+  ASSERT_TRUE (view == table);
+  ASSERT_EQ ("b", view.rawget ("a").cast <std::string> ());
+  ASSERT_EQ (7, luabridge::LuaStackRef (L, -2).cast <int> ());
+
+  luabridge::LuaRef copy = view;
+  lua_pop (L, 2);
+  ASSERT_TRUE (copy.rawequal (table));
+}
+
 TEST_F (LuaRefTests, Print)
 {
   {
@@ -0,0 +1,116 @@
+// https://github.com/vinniefalco/LuaBridge
+//
+// Copyright 2019, Dmitry Tarakanov
+// SPDX-License-Identifier: MIT
+
+#include "TestBase.h"
+
+#include "LuaBridge/MemoryBudget.h"
+#include "LuaBridge/SlabAllocator.h"
+
+#include <memory>
+
+
+struct MemoryBudgetTests : TestBase
+{
+  void SetUp () override
+  {
+  }
+
+  void openState (luabridge::MemoryBudget& budget)
+  {
+    L = lua_newstate (&luabridge::MemoryBudget::alloc, &budget);
+    luaL_openlibs (L);
+    lua_pushcfunction (L, &traceback);
+  }
+
+  void closeState ()
+  {
+    lua_close (L);
+    L = nullptr;
+  }
+
+  std::size_t luaBytesInUse () const
+  {
+    return static_cast <std::size_t> (lua_gc (L, LUA_GCCOUNT, 0)) * 1024 +
+      static_cast <std::size_t> (lua_gc (L, LUA_GCCOUNTB, 0));
+  }
+};
+
+TEST_F (MemoryBudgetTests, TracksBytesInUse)
+{
+  luabridge::MemoryBudget budget (16 * 1024 * 1024);
+  openState (budget);
+
+  ASSERT_EQ (luaBytesInUse (), budget.getBytesInUse ());
+
+  runLua ("t = {} for i = 1, 1000 do t [i] = tostring (i) end");
+  ASSERT_EQ (luaBytesInUse (), budget.getBytesInUse ());
+
+  std::size_t const peak = budget.getBytesInUse ();
+  runLua ("t = nil collectgarbage ()");
+  ASSERT_EQ (luaBytesInUse (), budget.getBytesInUse ());
+  ASSERT_LT (budget.getBytesInUse (), peak);
+  ASSERT_GE (budget.getPeakBytesInUse (), peak);
+  ASSERT_EQ (0u, budget.getFailedAllocations ());
+
+  closeState ();
+  ASSERT_EQ (0u, budget.getBytesInUse ());
+}
+
+TEST_F (MemoryBudgetTests, AllocationsOverBudgetFail)
+{
+  luabridge::MemoryBudget budget (16 * 1024 * 1024);
+  openState (budget);
+  budget.setBudget (budget.getBytesInUse () + 256 * 1024);
+
+  ASSERT_THROW (
+    runLua ("local t = {} for i = 1, 1000000 do t [i] = i end"),
+    std::runtime_error);
+  ASSERT_GT (budget.getFailedAllocations (), 0u);
+  ASSERT_LE (budget.getBytesInUse (), budget.getBudget ());
+
+  // The state is still usable once the garbage is collected
+  lua_settop (L, 1);
+  lua_gc (L, LUA_GCCOLLECT, 0);
+  runLua ("result = 42");
+  ASSERT_EQ (42, result ().cast <int> ());
+
+  closeState ();
+}
+
+#if LUA_VERSION_NUM >= 502
+
+TEST_F (MemoryBudgetTests, EmergencyCollectionFreesGarbage)
+{
+  luabridge::MemoryBudget budget (16 * 1024 * 1024);
+  openState (budget);
+  budget.setBudget (budget.getBytesInUse () + 256 * 1024);
+
+  // The regular collector would wait for the memory to grow tenfold
+  runLua (
+    "collectgarbage ('setpause', 1000) "
+    "for i = 1, 1000 do local s = string.rep ('x', 10000) .. i end "
+    "result = true");
+  ASSERT_TRUE (result ().cast <bool> ());
+  ASSERT_GT (budget.getFailedAllocations (), 0u);
+  ASSERT_LE (budget.getPeakBytesInUse (), budget.getBudget ());
+
+  closeState ();
+}
+
+#endif
+
+TEST_F (MemoryBudgetTests, WrapsAnotherAllocator)
+{
+  luabridge::SlabAllocator allocator;
+  luabridge::MemoryBudget budget (16 * 1024 * 1024, &luabridge::SlabAllocator::alloc, &allocator);
+  openState (budget);
+
+  runLua ("t = {} for i = 1, 1000 do t [i] = {} end");
+  ASSERT_EQ (allocator.getStatistics ().bytesInUse, budget.getBytesInUse ());
+  ASSERT_GT (allocator.getStatistics ().pooledAllocations, 1000u);
+
+  closeState ();
+  ASSERT_EQ (0u, allocator.getStatistics ().bytesInUse);
+}
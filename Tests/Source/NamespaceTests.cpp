@@ -5,6 +5,8 @@
 
 #include "TestBase.h"
 
+#include <stdexcept>
+
 
 struct NamespaceTests : TestBase
 {
@@ -171,3 +173,200 @@ TEST_F (NamespaceTests, StdCallFunctions)
 }
 
 #endif // _WINDOWS || WIN32
+
+namespace {
+
+std::string describe (int value)
+{
+  return "int " + std::to_string (value);
+}
+
+std::string describeString (std::string const& value)
+{
+  return "string " + value;
+}
+
+std::string describePair (int first, std::string const& second)
+{
+  return "pair " + std::to_string (first) + " " + second;
+}
+
+} // namespace
+
+TEST_F (NamespaceTests, OverloadedFunctions)
+{
+  luabridge::getGlobalNamespace (L)
+    .addFunction ("describe", &describe, &describeString, &describePair);
+
+  for (int i = 0; i < 2; ++i) // The second round hits the cache
+  {
+    runLua ("result = describe (1)");
+    ASSERT_EQ ("int 1", result ().cast <std::string> ());
+
+    runLua ("result = describe ('a')");
+    ASSERT_EQ ("string a", result ().cast <std::string> ());
+
+    runLua ("result = describe (2, 'b')");
+    ASSERT_EQ ("pair 2 b", result ().cast <std::string> ());
+  }
+
+  ASSERT_THROW (runLua ("describe ()"), std::runtime_error);
+  ASSERT_THROW (runLua ("describe ({})"), std::runtime_error);
+  ASSERT_THROW (runLua ("describe ('b', 2)"), std::runtime_error);
+}
+
+namespace {
+
+std::string takesCFunction (lua_CFunction f)
+{
+  return f != 0 ? "C function" : "null";
+}
+
+std::string takesRef (luabridge::LuaRef const& value)
+{
+  return std::string ("ref ") + lua_typename (value.state (), value.type ());
+}
+
+std::string takesState (int value, lua_State* L)
+{
+  return "state " + std::to_string (value + lua_gettop (L));
+}
+
+std::string takesStateFirst (lua_State* L, std::string const& value)
+{
+  return "state first " + value + " " + std::to_string (lua_gettop (L));
+}
+
+} // namespace
+
+TEST_F (NamespaceTests, OverloadsTakingTheState)
+{
+  luabridge::getGlobalNamespace (L)
+    .addFunction ("g", &takesState)
+    .addFunction ("f", &takesState, &takesStateFirst);
+
+  runLua ("result = g (1)");
+  ASSERT_EQ ("state 2", result ().cast <std::string> ());
+
+  runLua ("result = f (1)");
+  ASSERT_EQ ("state 2", result ().cast <std::string> ());
+
+  runLua ("result = f ('a')");
+  ASSERT_EQ ("state first a 1", result ().cast <std::string> ());
+
+  ASSERT_THROW (runLua ("f (1, 2)"), std::runtime_error);
+}
+
+TEST_F (NamespaceTests, OverloadsOfCFunctions)
+{
+  luabridge::getGlobalNamespace (L)
+    .addFunction ("f", &takesCFunction, &takesRef);
+
+  // Lua and C functions have the same Lua type, but not the same signature
+  runLua ("result = f (print)");
+  ASSERT_EQ ("C function", result ().cast <std::string> ());
+
+  runLua ("result = f (function () end)");
+  ASSERT_EQ ("ref function", result ().cast <std::string> ());
+
+  runLua ("result = f (print)");
+  ASSERT_EQ ("C function", result ().cast <std::string> ());
+}
+
+#ifdef LUABRIDGE_CXX17
+
+namespace {
+
+int add (int a, int b)
+{
+  return a + b;
+}
+
+int lastValue = 0;
+
+void store (int value)
+{
+  lastValue = value;
+}
+
+} // namespace
+
+TEST_F (NamespaceTests, InlineFunctions)
+{
+  luabridge::getGlobalNamespace (L)
+    .addFunction <&add> ("add")
+    .beginNamespace ("ns")
+      .addFunction <&store> ("store")
+    .endNamespace ();
+
+  runLua ("result = add (2, 3)");
+  ASSERT_TRUE (result ().isNumber ());
+  ASSERT_EQ (5, result ().cast <int> ());
+
+  runLua ("ns.store (42)");
+  ASSERT_EQ (42, lastValue);
+}
+
+#endif // LUABRIDGE_CXX17
+
+#if defined (__cpp_noexcept_function_type)
+
+namespace {
+
+int twice (int value) noexcept
+{
+  return 2 * value;
+}
+
+int fail (int)
+{
+  throw std::logic_error ("fail");
+}
+
+struct Counter
+{
+  int next () noexcept
+  {
+    return ++count;
+  }
+
+  int count = 0;
+};
+
+struct Unregistered
+{
+};
+
+Unregistered makeUnregistered () noexcept
+{
+  return Unregistered ();
+}
+
+} // namespace
+
+TEST_F (NamespaceTests, NoexceptFunctions)
+{
+  luabridge::getGlobalNamespace (L)
+    .addFunction ("twice", &twice)
+    .addFunction ("fail", &fail)
+    .addFunction ("makeUnregistered", &makeUnregistered)
+    .beginClass <Counter> ("Counter")
+    .addConstructor <void (*) ()> ()
+    .addFunction ("next", &Counter::next)
+    .endClass ();
+
+  runLua ("result = twice (21)");
+  ASSERT_EQ (42, result ().cast <int> ());
+
+  runLua ("local counter = Counter () counter:next () result = counter:next ()");
+  ASSERT_EQ (2, result ().cast <int> ());
+
+  ASSERT_THROW (runLua ("fail (1)"), std::runtime_error);
+
+  // Converting the result may still throw.
+  runLua ("ok, result = pcall (makeUnregistered)");
+  ASSERT_NE (std::string::npos,
+    result ().cast <std::string> ().find ("not registered"));
+}
+
+#endif // __cpp_noexcept_function_type
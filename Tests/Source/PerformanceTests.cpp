@@ -76,6 +76,14 @@ struct A
   {
   }
 
+  void of (int)
+  {
+  }
+
+  void of (char const*)
+  {
+  }
+
   virtual void vf1 ()
   {
   }
@@ -93,6 +101,16 @@ struct A
   }
 };
 
+/**
+  A class without properties, whose methods are looked up by the Lua VM.
+*/
+struct B
+{
+  void mf1 ()
+  {
+  }
+};
+
 //------------------------------------------------------------------------------
 
 void addToState (lua_State* L)
@@ -103,44 +121,95 @@ void addToState (lua_State* L)
       .addFunction ("mf1", &A::mf1)
       .addFunction ("mf2", &A::mf2)
       .addFunction ("mf3", &A::mf3)
+      .addFunction ("of",
+                    static_cast <void (A::*) (int)> (&A::of),
+                    static_cast <void (A::*) (char const*)> (&A::of))
+      .addFunction ("ofInt", static_cast <void (A::*) (int)> (&A::of))
+      .addFunction ("ofString", static_cast <void (A::*) (char const*)> (&A::of))
       .addFunction ("vf1", &A::vf1)
       .addData ("data",  &A::data)
       .addProperty ("prop", &A::getprop, &A::setprop)
+#ifdef LUABRIDGE_CXX17
+      .addFunction <&A::mf1> ("inlineMf1")
+#endif
     .endClass ()
+    .beginClass <B> ("B")
+      .addConstructor <void (*)(void)> ()
+      .addFunction ("mf1", &B::mf1)
+    .endClass ()
+    .addCFunction ("bind", &bindMethod)
+    .addCFunction ("each", &callEach)
     ;
 }
 
-void runTests (lua_State* L)
+/**
+  Measure a statement repeated in a Lua loop, so that the time is not
+  dominated by calling into Lua from C++.
+*/
+void runTest (lua_State* L, char const* name, char const* statement)
 {
-  cout.precision (4);
-
   int result;
 
-  luaL_dostring (L, "a = A()");
-
   int const trials = 5;
 
-  for (int trial = 0; trial < trials; ++trial)
-  {
-    result = luaL_loadstring (L, "a:mf1 ()");
-    if (result != 0)
-      lua_error (L);
+  cout << name << endl;
 
-    int const N = 10000000;
+  std::string const chunk =
+    std::string ("local a, b, bound, objects = a, b, bound, objects\n") +
+    "for i = 1, 10000000 do\n" +
+    "  " + statement + "\n" +
+    "end";
 
+  result = luaL_loadstring (L, chunk.c_str ());
+  if (result != 0)
+    lua_error (L);
+
+  for (int trial = 0; trial < trials; ++trial)
+  {
     Stopwatch sw;
 
     sw.start ();
-    for (int i = 0; i < N; ++i)
-    {
-      lua_pushvalue (L, -1);
-      lua_call (L, 0, 0);
-    }
+    lua_pushvalue (L, -1);
+    lua_call (L, 0, 0);
 
     double const seconds = sw.getElapsedSeconds ();
 
     cout << "Elapsed time: " << seconds << endl;
   }
+
+  lua_pop (L, 1);
+}
+
+void runTests (lua_State* L)
+{
+  cout.precision (4);
+
+  luaL_dostring (L, "a = A()");
+  luaL_dostring (L, "b = B()");
+  luaL_dostring (L, "bound = bind (a, 'mf1')");
+  luaL_dostring (L, "objects = {} for i = 1, 1000 do objects [i] = A () end");
+  luaL_dostring (L,
+    "function of (a, x)"
+    "  if type (x) == 'number' then a:ofInt (x) else a:ofString (x) end "
+    "end");
+
+  runTest (L, "Member function call", "a:mf1 ()");
+  runTest (L, "Member function call, no properties", "b:mf1 ()");
+  runTest (L, "Bound member function call", "bound ()");
+  runTest (L, "Member function call on array elements",
+    "objects [i % 1000 + 1]:mf1 ()");
+  runTest (L, "Member function called on each array element",
+    "if i % 1000 == 0 then each (objects, 'mf1') end");
+  runTest (L, "Member function call with object argument", "a:mf2 (a)");
+  runTest (L, "Overloaded member function call", "a:of (1) a:of ('x')");
+  runTest (L, "Overloads dispatched in Lua", "of (a, 1) of (a, 'x')");
+#ifdef LUABRIDGE_CXX17
+  runTest (L, "Inline member function call", "a:inlineMf1 ()");
+#endif
+  runTest (L, "Data member read", "local x = a.data");
+  runTest (L, "Data member write", "a.data = 1");
+  runTest (L, "Property read", "local x = a.prop");
+  runTest (L, "Property write", "a.prop = 1");
 }
 
 void runPerformanceTests ()
@@ -0,0 +1,118 @@
+// https://github.com/vinniefalco/LuaBridge
+//
+// Copyright 2019, Dmitry Tarakanov
+// SPDX-License-Identifier: MIT
+
+#include "TestBase.h"
+
+#include "LuaBridge/SlabAllocator.h"
+
+#include <memory>
+
+
+struct SlabAllocatorTests : TestBase
+{
+  void SetUp () override
+  {
+    allocator.reset (new luabridge::SlabAllocator ());
+  }
+
+  void openState ()
+  {
+    L = lua_newstate (&luabridge::SlabAllocator::alloc, allocator.get ());
+    luaL_openlibs (L);
+    lua_pushcfunction (L, &traceback);
+  }
+
+  void closeState ()
+  {
+    lua_close (L);
+    L = nullptr;
+  }
+
+  std::unique_ptr <luabridge::SlabAllocator> allocator;
+};
+
+namespace {
+
+struct Vec4
+{
+  Vec4 (float x, float y, float z, float w)
+    : x (x), y (y), z (z), w (w)
+  {
+  }
+
+  float dot (Vec4 const& other) const
+  {
+    return x * other.x + y * other.y + z * other.z + w * other.w;
+  }
+
+  float x, y, z, w;
+};
+
+} // namespace
+
+TEST_F (SlabAllocatorTests, ReusesFreedBlocks)
+{
+  allocator->addClass <Vec4> ();
+  openState ();
+
+  luabridge::getGlobalNamespace (L)
+    .beginClass <Vec4> ("Vec4")
+    .addConstructor <void (*) (float, float, float, float)> ()
+    .addFunction ("dot", &Vec4::dot)
+    .endClass ();
+
+  // Finalized userdata are freed by the next collection
+  runLua (
+    "function run () "
+    "  collectgarbage ('stop') "
+    "  result = 0 "
+    "  for i = 1, 10000 do "
+    "    local v = Vec4 (i, 1, 0, 0) "
+    "    result = result + v:dot (Vec4 (1, 0, 0, 0)) "
+    "  end "
+    "  collectgarbage () "
+    "  collectgarbage () "
+    "  collectgarbage ('restart') "
+    "end");
+
+  runLua ("run ()");
+  ASSERT_EQ (50005000, result ().cast <int> ());
+
+  luabridge::SlabAllocator::Statistics const& statistics = allocator->getStatistics ();
+  ASSERT_GT (statistics.pooledAllocations, 20000u);
+  ASSERT_GT (statistics.bytesInUse, 0u);
+
+  std::size_t const slabs = statistics.slabs;
+  runLua ("run ()");
+  ASSERT_EQ (slabs, statistics.slabs);
+
+  closeState ();
+  ASSERT_EQ (statistics.allocations, statistics.deallocations);
+  ASSERT_EQ (0u, statistics.bytesInUse);
+}
+
+TEST_F (SlabAllocatorTests, LargeBlocks)
+{
+  openState ();
+
+  runLua (
+    "local parts = {} "
+    "for i = 1, 1000 do parts [i] = string.rep ('x', i) end "
+    "result = #table.concat (parts)");
+  ASSERT_EQ (500500, result ().cast <int> ());
+
+  closeState ();
+  ASSERT_EQ (0u, allocator->getStatistics ().bytesInUse);
+}
+
+TEST_F (SlabAllocatorTests, SizeClassesAreFixedOnceUsed)
+{
+  allocator->addSize (1000);
+  ASSERT_EQ (1008u, allocator->getMaxBlockSize ());
+
+  openState ();
+  ASSERT_THROW (allocator->addClass <Vec4> (), std::logic_error);
+  closeState ();
+}
@@ -14,6 +14,8 @@
 #include <gtest/gtest.h>
 
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 
 // traceback function, adapted from lua.c
@@ -86,6 +88,23 @@ struct TestBase : public ::testing::Test
     luabridge::setGlobal (L, luabridge::LuaRef (L), "result");
   }
 
+  /// The raw contents of the array part of the registry, which holds the
+  /// references and their free list.
+  ///
+  std::vector <std::string> getRegistryRefs ()
+  {
+    std::vector <std::string> refs;
+    int const size = static_cast <int> (luabridge::get_length (L, LUA_REGISTRYINDEX));
+    for (int i = 0; i <= size + 1; ++i)
+    {
+      lua_rawgeti (L, LUA_REGISTRYINDEX, i);
+      refs.push_back (std::string (luaL_typename (L, -1)) + ":" +
+        (lua_isnumber (L, -1) ? lua_tostring (L, -1) : ""));
+      lua_pop (L, 1);
+    }
+    return refs;
+  }
+
   void printStack ()
   {
     std::cerr << "===== Stack =====\n";